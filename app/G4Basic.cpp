@@ -10,15 +10,13 @@
 #include "PrimaryGeneration.h"
 #include "SteppingAction.h"
 #include "RunAction.h"
+#include "PhysicsList.h"
+#include "TrackingAction.h"
 
 #include <G4RunManager.hh>
 #include <G4UImanager.hh>
 #include <G4VisExecutive.hh>
 #include <G4UIExecutive.hh>
-#include <FTFP_BERT_HP.hh>
-#include <G4EmStandardPhysics_option4.hh>
-#include <G4OpticalPhysics.hh>
-#include <G4RadioactiveDecayPhysics.hh>
 
 #include "TFile.h"
 #include "TTree.h"
@@ -36,12 +34,9 @@ int main(int argc, char** argv)
   // Construct the run manager and set the initialization classes
   G4RunManager* runmgr = new G4RunManager();
 
-  // Set the physics used for this simulation
-  G4VModularPhysicsList* physics_list = new G4VModularPhysicsList();
-  physics_list->RegisterPhysics(new G4OpticalPhysics());
-  physics_list->RegisterPhysics(new G4EmStandardPhysics_option4());
-  physics_list->RegisterPhysics(new G4RadioactiveDecayPhysics());
-  runmgr->SetUserInitialization(physics_list);
+  // Set the physics used for this simulation (profile selected
+  // through /G4Basic/physics/ before initialization)
+  runmgr->SetUserInitialization(new PhysicsList());
 
   // set up detector geometry
   runmgr->SetUserInitialization(new DetectorConstruction());
@@ -52,7 +47,9 @@ int main(int argc, char** argv)
   runmgr->SetUserAction(new PrimaryGeneration(runAction));
   EventAction* eventAction = new EventAction(runAction);
   runmgr->SetUserAction(eventAction);
-  runmgr->SetUserAction(new SteppingAction(eventAction, runAction));
+  TrackingAction* trackingAction = new TrackingAction(eventAction);
+  runmgr->SetUserAction(trackingAction);
+  runmgr->SetUserAction(new SteppingAction(eventAction, runAction, trackingAction));
 
   // Initialize visualization
   G4VisManager* vismgr = new G4VisExecutive();
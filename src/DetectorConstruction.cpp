@@ -7,6 +7,7 @@
 // -----------------------------------------------------------------------------
 
 #include "DetectorConstruction.h"
+#include "XenonGasProperties.h"
 
 #include <G4Box.hh>
 #include <G4Tubs.hh>
@@ -19,18 +20,78 @@
 #include <G4OpticalSurface.hh>
 #include <G4LogicalSkinSurface.hh>
 #include <G4LogicalBorderSurface.hh>
+#include <G4Region.hh>
+#include <G4RegionStore.hh>
+#include <G4ProductionCuts.hh>
+#include <G4UserLimits.hh>
+#include <G4RunManagerKernel.hh>
+#include <G4VUserPhysicsList.hh>
+#include <G4GenericMessenger.hh>
 
 DetectorConstruction::DetectorConstruction()
   : G4VUserDetectorConstruction(),
     fEnergyPlane(0),
     fTrackingPlane(0),
-    fpressure(15.*bar)
+    fpressure(15.*bar),
+    ftemperature(300.*kelvin),
+    fGXeTableFile("GXe_tables.bin"),
+    fChamberRadius(0.),
+    fChamberLength(0.),
+    fMessenger(0),
+    fRegionMessenger(0),
+    fActiveRegion(0), fPassiveRegion(0), fBarrelRegion(0), fWorldRegion(0),
+    fActiveCut(0.), fPassiveCut(0.), fBarrelCut(0.), fWorldCut(0.),
+    fActiveMaxStep(0.), fPassiveMaxStep(0.), fBarrelMaxStep(0.), fWorldMaxStep(0.),
+    fKillInPassive(false), fKillInBarrel(false), fKillInWorld(false)
 {
+  // Detector and region settings are read in Construct(), so they
+  // must be given before /run/initialize.
+  fMessenger = new G4GenericMessenger(this, "/G4Basic/detector/",
+    "Control of the detector geometry and materials.");
+
+  fMessenger->DeclarePropertyWithUnit("pressure", "bar", fpressure,
+    "Pressure of the xenon gas.");
+  fMessenger->DeclarePropertyWithUnit("temperature", "kelvin", ftemperature,
+    "Temperature of the xenon gas.");
+  fMessenger->DeclareProperty("gxeTableFile", fGXeTableFile,
+    "Binary file caching the GXe property tables (none to always regenerate).");
+
+  fRegionMessenger = new G4GenericMessenger(this, "/G4Basic/regions/",
+    "Production cuts and user limits per detector region.");
+
+  fRegionMessenger->DeclarePropertyWithUnit("activeCut", "mm", fActiveCut,
+    "Production cut in the active GXe region (0 = physics list default cut).");
+  fRegionMessenger->DeclarePropertyWithUnit("passiveCut", "mm", fPassiveCut,
+    "Production cut in the copper planes (0 = physics list default cut).");
+  fRegionMessenger->DeclarePropertyWithUnit("barrelCut", "mm", fBarrelCut,
+    "Production cut in the polyethylene barrel (0 = physics list default cut).");
+  fRegionMessenger->DeclarePropertyWithUnit("worldCut", "mm", fWorldCut,
+    "Production cut in the world (default region) only; the other regions "
+    "keep their own cuts (0 = physics list default cut). When set, the other "
+    "regions no longer follow /run/setCut.");
+
+  fRegionMessenger->DeclarePropertyWithUnit("activeMaxStep", "mm", fActiveMaxStep,
+    "Maximum step length in the active GXe region (0 = no limit).");
+  fRegionMessenger->DeclarePropertyWithUnit("passiveMaxStep", "mm", fPassiveMaxStep,
+    "Maximum step length in the copper planes (0 = no limit).");
+  fRegionMessenger->DeclarePropertyWithUnit("barrelMaxStep", "mm", fBarrelMaxStep,
+    "Maximum step length in the polyethylene barrel (0 = no limit).");
+  fRegionMessenger->DeclarePropertyWithUnit("worldMaxStep", "mm", fWorldMaxStep,
+    "Maximum step length in the world volume (0 = no limit).");
+
+  fRegionMessenger->DeclareProperty("killInPassive", fKillInPassive,
+    "Kill particles as soon as they enter the copper planes.");
+  fRegionMessenger->DeclareProperty("killInBarrel", fKillInBarrel,
+    "Kill particles as soon as they enter the polyethylene barrel.");
+  fRegionMessenger->DeclareProperty("killInWorld", fKillInWorld,
+    "Kill particles as soon as they enter the world volume.");
 }
 
 
 DetectorConstruction::~DetectorConstruction()
 {
+  delete fMessenger;
+  delete fRegionMessenger;
 }
 
 
@@ -153,6 +214,32 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   new G4PVPlacement(0, energy_pos,
                     energy_logic_vol, energy_name, world_logic_vol, false, 0, true);
 
+  /////////////////////////////////////////////////////////////////////////////
+  // REGIONS
+  /////////////////////////////////////////////////////////////////////////////
+
+  fActiveRegion = new G4Region("ACTIVE");
+  fActiveRegion->AddRootLogicalVolume(xenon_logic_vol);
+  SetRegionLimits(fActiveRegion, fActiveCut, fActiveMaxStep);
+
+  fPassiveRegion = new G4Region("PASSIVE");
+  fPassiveRegion->AddRootLogicalVolume(tracking_logic_vol);
+  fPassiveRegion->AddRootLogicalVolume(energy_logic_vol);
+  SetRegionLimits(fPassiveRegion, fPassiveCut, fPassiveMaxStep);
+
+  fBarrelRegion = new G4Region("BARREL");
+  fBarrelRegion->AddRootLogicalVolume(barrel_logic_vol);
+  SetRegionLimits(fBarrelRegion, fBarrelCut, fBarrelMaxStep);
+
+  // The world belongs to the default region, whose production cuts are
+  // owned by the physics list and reset when physics is initialized.
+  // This must come after the other regions have copied the default cut.
+  fWorldRegion = G4RegionStore::GetInstance()->GetRegion("DefaultRegionForTheWorld", false);
+  if (fWorldCut > 0.)
+    G4RunManagerKernel::GetRunManagerKernel()->GetPhysicsList()->SetDefaultCutValue(fWorldCut);
+  if (fWorldMaxStep > 0.)
+    fWorldRegion->SetUserLimits(new G4UserLimits(fWorldMaxStep));
+
   /////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////////
   // SET VISIBILITY ATTRIBUTES
@@ -171,44 +258,72 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
 
   fEnergyPlane = energy_logic_vol;
   fTrackingPlane = tracking_logic_vol;
+  fChamberRadius = xenon_diam/2.;
+  fChamberLength = xenon_length;
 
   return world_phys_vol;
 }
 
 
+void DetectorConstruction::SetRegionLimits(G4Region* region, G4double cut,
+                                           G4double max_step) const
+{
+  // Regions without production cuts share those of the default region, and
+  // so follow /run/setCut. They only get cuts of their own when a cut is set
+  // for them, or when the world cut is set (which must leave them alone:
+  // they then keep a copy of the physics list default cut).
+
+  if (cut > 0. || fWorldCut > 0.) {
+    if (cut <= 0.)
+      cut = G4RunManagerKernel::GetRunManagerKernel()->GetPhysicsList()->GetDefaultCutValue();
+    G4ProductionCuts* cuts = new G4ProductionCuts();
+    cuts->SetProductionCut(cut);
+    region->SetProductionCuts(cuts);
+  }
+
+  if (max_step > 0.) region->SetUserLimits(new G4UserLimits(max_step));
+}
+
+
+G4bool DetectorConstruction::KillOnEntry(const G4Region* region) const
+{
+  return (fKillInPassive && region == fPassiveRegion) ||
+         (fKillInBarrel  && region == fBarrelRegion)  ||
+         (fKillInWorld   && region == fWorldRegion);
+}
+
+
 G4Material* DetectorConstruction::DefineXenon() const{
   // Defines the material and optical properties of gaseous xenon
 
   G4String material_name = "GXe";
-  G4double density = 88.56 * kg/m3;
-  //G4double pressure = 15.0 * bar;
-  G4double temperature = 300. * kelvin;
   G4double sc_yield = 20000*1/MeV; // Estimated ~50 photons/eV
 
-  G4Material* material = new G4Material(material_name, density, 1,
-			    kStateGas, temperature, fpressure);
+  // Density and optical tables follow the pressure and temperature.
+  // They are read from the cache file if it matches the conditions,
+  // otherwise generated and saved for the next job.
+  XenonGasProperties properties;
+  if (fGXeTableFile == "none" ||
+      !properties.Load(fGXeTableFile, fpressure, ftemperature)) {
+    properties.Generate(fpressure, ftemperature);
+    if (fGXeTableFile != "none") properties.Save(fGXeTableFile);
+  }
+
+  G4Material* material = new G4Material(material_name, properties.GetDensity(), 1,
+			    kStateGas, ftemperature, fpressure);
   G4Element* Xe = G4NistManager::Instance()->FindOrBuildElement("Xe");
   material->AddElement(Xe,1);
 
-  // Optical Properties of Xenon
-  // From Geant4 Liquid Xenon example
-  // FIXME: what should these number be for this gasous xenon detector???
-  const G4int GXe_NUMENTRIES = 3;
-  G4double GXe_Energy[GXe_NUMENTRIES]    = { 7.0*eV , 7.07*eV, 7.14*eV };
-  G4double GXe_SCINT[GXe_NUMENTRIES] = { 0.1, 1.0, 0.1 };
-  G4double GXe_RIND[GXe_NUMENTRIES]  = {1.0, 1.0, 1.0};
-  G4double GXe_ABSL[GXe_NUMENTRIES]  = {1.e8*m, 1.e8*m, 1.e8*m};
-
   G4MaterialPropertiesTable* GXe_mt = new G4MaterialPropertiesTable();
 
-  GXe_mt->AddProperty("FASTCOMPONENT", GXe_Energy, GXe_SCINT, GXe_NUMENTRIES);
-  GXe_mt->AddProperty("RINDEX",        GXe_Energy, GXe_RIND,  GXe_NUMENTRIES);
-  GXe_mt->AddProperty("ABSLENGTH",     GXe_Energy, GXe_ABSL,  GXe_NUMENTRIES);
+  GXe_mt->AddProperty("FASTCOMPONENT", properties.Scintillation());
+  GXe_mt->AddProperty("RINDEX",        properties.RefractiveIndex());
+  GXe_mt->AddProperty("ABSLENGTH",     properties.AbsorptionLength());
   GXe_mt->AddConstProperty("SCINTILLATIONYIELD",sc_yield);
   GXe_mt->AddConstProperty("RESOLUTIONSCALE",1.0);
   GXe_mt->AddConstProperty("FASTTIMECONSTANT",1.*ns);
   GXe_mt->AddConstProperty("YIELDRATIO",1.0);
-  GXe_mt->AddProperty("ELSPECTRUM", GXe_Energy, GXe_SCINT, GXe_NUMENTRIES);
+  GXe_mt->AddProperty("ELSPECTRUM", properties.Scintillation());
   GXe_mt->AddConstProperty("ELTIMECONSTANT", 50.*ns);
 
   material->SetMaterialPropertiesTable(GXe_mt);
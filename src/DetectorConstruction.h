@@ -13,6 +13,8 @@
 #include <G4MaterialPropertiesTable.hh>
 
 class G4Material;
+class G4Region;
+class G4GenericMessenger;
 
 
 class DetectorConstruction: public G4VUserDetectorConstruction
@@ -24,16 +26,38 @@ public:
 
   G4LogicalVolume* GetEnergyPlane() const { return fEnergyPlane; }
   G4LogicalVolume* GetTrackingPlane() const { return fTrackingPlane; }
+  G4double GetChamberRadius() const { return fChamberRadius; }
+  G4double GetChamberLength() const { return fChamberLength; }
+
+  // Returns true if particles entering the given region must be killed
+  G4bool KillOnEntry(const G4Region* region) const;
 
 private:
   G4Material* DefineXenon() const;
   G4MaterialPropertiesTable* PTFE();
   G4MaterialPropertiesTable* OpticalPlane();
   G4MaterialPropertiesTable* TransparentMaterialsTable();
+  void SetRegionLimits(G4Region* region, G4double cut, G4double max_step) const;
 
   G4LogicalVolume* fEnergyPlane;
   G4LogicalVolume* fTrackingPlane;
   G4double fpressure;
+  G4double ftemperature;
+  G4String fGXeTableFile; // cache of the GXe property tables
+  G4double fChamberRadius;
+  G4double fChamberLength;
+
+  G4GenericMessenger* fMessenger;
+  G4GenericMessenger* fRegionMessenger;
+
+  G4Region* fActiveRegion;  // GXe
+  G4Region* fPassiveRegion; // copper planes
+  G4Region* fBarrelRegion;  // polyethylene barrel
+  G4Region* fWorldRegion;   // air (default region)
+
+  G4double fActiveCut, fPassiveCut, fBarrelCut, fWorldCut; // 0 = default cuts
+  G4double fActiveMaxStep, fPassiveMaxStep, fBarrelMaxStep, fWorldMaxStep; // 0 = no limit
+  G4bool fKillInPassive, fKillInBarrel, fKillInWorld;
 };
 
 #endif
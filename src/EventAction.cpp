@@ -7,32 +7,154 @@
 // -----------------------------------------------------------------------------
 
 #include "EventAction.h"
+#include "Telemetry.h"
+#include "HeapAccounting.h"
+#include "Log.h"
+
+#include <G4Event.hh>
+#include <G4RunManager.hh>
+#include <G4GenericMessenger.hh>
+#include <G4SystemOfUnits.hh>
+#include <G4OpticalPhoton.hh>
+#include <G4Gamma.hh>
+#include <G4Electron.hh>
+
+#include <climits>
+#include <sstream>
+
+namespace {
+  // Steps between two checks of the event time budget
+  const G4int kTimeCheckInterval = 1000;
+}
+
 
 EventAction::EventAction(RunAction* runAction)
   : G4UserEventAction(),
     fRunAction(runAction),
-    fEdep(0.)
+    fMessenger(0),
+    fEdep(0.),
+    fNumSteps(0),
+    fAccounting(false),
+    fHeapAtStart(0.),
+    fNumOpticals(0), fNumGammas(0), fNumElectrons(0), fNumOthers(0),
+    fMaxSteps(0),
+    fMaxTime(0.),
+    fWatchdogAction("flag"),
+    fNextCheck(INT_MAX),
+    fWatchdog(0)
 {
+  fMessenger = new G4GenericMessenger(this, "/G4Basic/event/",
+    "Per-event resource accounting and watchdog.");
+
+  fMessenger->DeclareProperty("accounting", fAccounting,
+    "Record wall time, steps, tracks by type and peak heap growth of each "
+    "event in tree1 (memory reused from earlier events is not counted).");
+  fMessenger->DeclareProperty("maxSteps", fMaxSteps,
+    "Step budget of an event (0 = no budget).");
+  fMessenger->DeclarePropertyWithUnit("maxTime", "s", fMaxTime,
+    "Wall-time budget of an event (0 = no budget).");
+  fMessenger->DeclareProperty("watchdogAction", fWatchdogAction,
+    "What to do with events over budget: kill (abort them) or flag.")
+    .SetCandidates("kill flag");
 }
 
 
 EventAction::~EventAction()
 {
+  delete fMessenger;
 }
 
 
 void EventAction::BeginOfEventAction(const G4Event*)
 {
-  G4cout << "%%%%%%%%%%%%%%%%%%%%%%%% BEGIN EVENT "<<fRunAction->EventNum()+1<<"  %%%%%%%%%%%%%%%%%%%%%%%%\n"<<G4endl;
+  G4BASIC_LOG(Log::kInfo, "%%%%%%%%%%%%%%%%%%%%%%%% BEGIN EVENT "<<fRunAction->EventNum()+1<<"  %%%%%%%%%%%%%%%%%%%%%%%%\n");
   fEdep = 0.;
+  fNumSteps = 0;
   //fNumPhotons = 0;
   fTrackMap.clear();
+
+  fStart = Clock::now();
+  if (fAccounting) {
+    HeapAccounting::ResetPeak();
+    fHeapAtStart = HeapAccounting::CurrentBytes();
+    fNumOpticals = fNumGammas = fNumElectrons = fNumOthers = 0;
+  }
+
+  // The first check comes at the step budget, or earlier if the
+  // time budget has to be polled
+  fWatchdog = 0;
+  fNextCheck = INT_MAX;
+  if (fMaxTime > 0.) fNextCheck = kTimeCheckInterval;
+  if (fMaxSteps > 0 && fMaxSteps < fNextCheck) fNextCheck = fMaxSteps;
 }
 
 
-void EventAction::EndOfEventAction(const G4Event*)
+void EventAction::EndOfEventAction(const G4Event* event)
 {
+  // Events without primaries (e.g. once a primary input file is
+  // exhausted and the run is being aborted) are not recorded
+  if (event->GetNumberOfPrimaryVertex() == 0) return;
+
   fRunAction->AddEdep(fEdep);
+  fRunAction->GetTelemetry()->EndOfEvent(fNumSteps);
+
+  if (fAccounting) {
+    EventAccounting accounting;
+    accounting.walltime = ElapsedTime()/ms;
+    accounting.nsteps = fNumSteps;
+    accounting.nopticals = fNumOpticals;
+    accounting.ngammas = fNumGammas;
+    accounting.nelectrons = fNumElectrons;
+    accounting.nothers = fNumOthers;
+    accounting.peakheap = (HeapAccounting::PeakBytes() - fHeapAtStart)/1.e6;
+    accounting.watchdog = fWatchdog;
+    fRunAction->FillAccounting(accounting);
+  }
+
   //G4cout << "%%%%%%%%%%%%%%%%%%%%%%%% END EVENT %%%%%%%%%%%%%%%%%%%%%%%%\n"<<G4endl;
   fRunAction->NextEvent();
 }
+
+
+void EventAction::AddTrack(const G4ParticleDefinition* particle)
+{
+  if      (particle == G4OpticalPhoton::Definition()) fNumOpticals++;
+  else if (particle == G4Gamma::Definition())         fNumGammas++;
+  else if (particle == G4Electron::Definition())      fNumElectrons++;
+  else                                                fNumOthers++;
+}
+
+
+G4double EventAction::ElapsedTime() const
+{
+  return std::chrono::duration<G4double>(Clock::now() - fStart).count()*s;
+}
+
+
+void EventAction::CheckBudget()
+{
+  // Called from AddStep() only when the step count reaches fNextCheck
+
+  G4bool over_steps = fMaxSteps > 0 && fNumSteps >= fMaxSteps;
+  G4bool over_time  = fMaxTime > 0. && ElapsedTime() >= fMaxTime;
+
+  if (!over_steps && !over_time) {
+    fNextCheck = fNumSteps + kTimeCheckInterval;
+    if (fMaxSteps > 0 && fMaxSteps < fNextCheck) fNextCheck = fMaxSteps;
+    return;
+  }
+
+  G4bool kill = (fWatchdogAction == "kill");
+  fWatchdog = kill ? 2 : 1;
+  fNextCheck = INT_MAX; // report each event only once
+
+  std::ostringstream msg;
+  msg << "event " << fRunAction->EventNum() << " over its "
+      << (over_steps ? "step" : "time") << " budget after " << fNumSteps
+      << " steps and " << ElapsedTime()/s << " s, "
+      << (kill ? "aborted" : "flagged");
+  G4Exception("EventAction::CheckBudget()", "[EventAction]",
+              JustWarning, msg.str().c_str());
+
+  if (kill) G4RunManager::GetRunManager()->AbortEvent();
+}
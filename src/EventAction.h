@@ -13,6 +13,11 @@
 
 #include <G4UserEventAction.hh>
 
+#include <chrono>
+
+class G4ParticleDefinition;
+class G4GenericMessenger;
+
 class EventAction: public G4UserEventAction
 {
 public:
@@ -22,14 +27,36 @@ public:
   virtual void EndOfEventAction(const G4Event*);
 
   void AddEdep(G4double edep) { fEdep += edep;}
+  void AddStep() { if (++fNumSteps >= fNextCheck) CheckBudget(); }
+  void AddTrack(const G4ParticleDefinition* particle);
   void FillTrackMap(G4int trackid) {fTrackMap[trackid] = trackid;}
   std::map<int, int> GetTrackMap() {return fTrackMap;}
   //void AddNumPhotons() {fNumPhotons++;}
 
  private:
+  typedef std::chrono::steady_clock Clock;
+
+  void CheckBudget();
+  G4double ElapsedTime() const; // since the start of the event, in G4 units
+
   RunAction* fRunAction;
+  G4GenericMessenger* fMessenger;
   G4double fEdep;
+  G4int fNumSteps;
   std::map<int, int> fTrackMap;
+
+  // Resource accounting
+  G4bool fAccounting;
+  Clock::time_point fStart;
+  G4double fHeapAtStart;
+  G4int fNumOpticals, fNumGammas, fNumElectrons, fNumOthers;
+
+  // Watchdog
+  G4int fMaxSteps;       // 0 = no budget
+  G4double fMaxTime;     // 0 = no budget
+  G4String fWatchdogAction; // kill or flag
+  G4int fNextCheck;      // step count of the next budget check
+  G4int fWatchdog;       // 0 within budget, 1 flagged, 2 killed
 };
 
 #endif
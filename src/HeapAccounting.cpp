@@ -0,0 +1,86 @@
+// -----------------------------------------------------------------------------
+//  G4Basic | HeapAccounting.cpp
+//
+//  Heap usage bookkeeping through the global operator new and delete.
+//   * Author: Taylor Contreras, Justo Martin-Albo
+//   * Creation date: 18 Oct 2026
+// -----------------------------------------------------------------------------
+
+#include "HeapAccounting.h"
+
+#ifdef G4BASIC_HEAP_ACCOUNTING
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <malloc.h>
+
+namespace {
+  std::atomic<long> current_bytes(0);
+  std::atomic<long> peak_bytes(0);
+}
+
+// The array forms of the standard library forward to these, so every heap
+// allocation is counted. The nothrow forms are replaced as well: libstdc++
+// only forwards them to operator new since GCC 9, and before that memory
+// they allocate would be uncounted but freed through the counted delete.
+// Sizes are taken from malloc_usable_size() so that delete needs none.
+
+namespace {
+  void* Allocate(std::size_t size)
+  {
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr) return 0;
+
+    long size_used = malloc_usable_size(ptr);
+    long now = current_bytes.fetch_add(size_used, std::memory_order_relaxed) + size_used;
+    if (now > peak_bytes.load(std::memory_order_relaxed))
+      peak_bytes.store(now, std::memory_order_relaxed);
+    return ptr;
+  }
+}
+
+void* operator new(std::size_t size)
+{
+  void* ptr = Allocate(size);
+  if (!ptr) throw std::bad_alloc();
+  return ptr;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+  return Allocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+  if (!ptr) return;
+  current_bytes.fetch_sub(malloc_usable_size(ptr), std::memory_order_relaxed);
+  std::free(ptr);
+}
+
+// Used by C++14 compilers for objects of known size; not every standard
+// library forwards its default version to the replaced unsized delete
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  operator delete(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+  operator delete(ptr);
+}
+
+G4bool   HeapAccounting::Enabled()      { return true; }
+G4double HeapAccounting::CurrentBytes() { return current_bytes.load(std::memory_order_relaxed); }
+G4double HeapAccounting::PeakBytes()    { return peak_bytes.load(std::memory_order_relaxed); }
+void     HeapAccounting::ResetPeak()    { peak_bytes.store(current_bytes.load()); }
+
+#else
+
+G4bool   HeapAccounting::Enabled()      { return false; }
+G4double HeapAccounting::CurrentBytes() { return 0.; }
+G4double HeapAccounting::PeakBytes()    { return 0.; }
+void     HeapAccounting::ResetPeak()    {}
+
+#endif
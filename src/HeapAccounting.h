@@ -0,0 +1,33 @@
+// -----------------------------------------------------------------------------
+//  G4Basic | HeapAccounting.h
+//
+//  Heap usage bookkeeping through replacements of the global operator new
+//  and operator delete. It is only compiled in with the CMake option
+//  G4BASIC_HEAP_ACCOUNTING; otherwise all counters read zero. Memory kept
+//  for reuse, such as the G4Allocator pools of tracks and trajectories or
+//  the capacity of the track stacks, stays counted once allocated, so the
+//  counters measure heap growth rather than the memory used by an event.
+//   * Author: Taylor Contreras, Justo Martin-Albo
+//   * Creation date: 18 Oct 2026
+// -----------------------------------------------------------------------------
+
+#ifndef HEAP_ACCOUNTING_H
+#define HEAP_ACCOUNTING_H
+
+#include "globals.hh"
+
+namespace HeapAccounting {
+
+  // Whether the allocator hook is compiled in
+  G4bool Enabled();
+
+  // Bytes currently allocated through operator new
+  G4double CurrentBytes();
+
+  // Highest value of CurrentBytes() since the last ResetPeak()
+  G4double PeakBytes();
+  void ResetPeak();
+
+}
+
+#endif
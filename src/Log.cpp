@@ -0,0 +1,244 @@
+// -----------------------------------------------------------------------------
+//  G4Basic | Log.cpp
+//
+//  Verbosity-gated logging with an asynchronous backend.
+//   * Author: Taylor Contreras, Justo Martin-Albo
+//   * Creation date: 18 Oct 2026
+// -----------------------------------------------------------------------------
+
+#include "Log.h"
+
+#include <G4ios.hh>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+G4int Log::verbosity = Log::kQuiet;
+G4bool Log::async = true;
+G4String Log::file = "none";
+
+namespace {
+
+  // Single-producer single-consumer ring of fixed-size message slots.
+  // The owning thread only advances fHead, the drain only advances fTail.
+  struct RingBuffer {
+    static const size_t kSlots = 16384;
+    static const size_t kSlotSize = 256; // longer messages are truncated
+
+    struct Slot {
+      size_t length;
+      char text[kSlotSize];
+    };
+
+    RingBuffer(): fHead(0), fTail(0), fDropped(0) {}
+
+    Slot fSlots[kSlots];
+    std::atomic<size_t> fHead;
+    std::atomic<size_t> fTail;
+    std::atomic<size_t> fDropped; // messages lost because the ring was full
+  };
+
+
+  // Stream buffer writing straight into a slot, silently truncating
+  class SlotBuffer: public std::streambuf {
+  public:
+    void Reset(char* begin, size_t size) { setp(begin, begin + size); }
+    size_t Length() const { return pptr() - pbase(); }
+  protected:
+    virtual int_type overflow(int_type c) { return traits_type::not_eof(c); }
+  };
+
+
+  struct ThreadState {
+    ThreadState(): fRing(0), fStream(&fBuffer), fSlot(0), fDropping(false) {}
+    RingBuffer* fRing;
+    SlotBuffer fBuffer;
+    std::ostream fStream;
+    size_t fSlot;
+    bool fDropping;
+    RingBuffer::Slot fScratch; // target of messages that do not fit
+  };
+
+
+  class Backend {
+  public:
+    Backend(): fActive(false), fStop(false), fOutput(stdout) {}
+    ~Backend()
+    {
+      Stop();
+      for (size_t i=0; i<fRings.size(); i++) delete fRings[i];
+    }
+
+    RingBuffer* Register()
+    {
+      std::lock_guard<std::mutex> lock(fRingsMutex);
+      fRings.push_back(new RingBuffer());
+      return fRings.back();
+    }
+
+    void Start(const G4String& filename)
+    {
+      if (Active() && filename == fFileName) return;
+      Stop();
+      fFileName = filename;
+      fOutput = stdout;
+      if (filename != "none") {
+        fOutput = std::fopen(filename.c_str(), "w");
+        if (!fOutput) {
+          G4cerr << "Log: cannot open " << filename << ", using stdout" << G4endl;
+          fOutput = stdout;
+        }
+      }
+      fStop = false;
+      fThread = std::thread(&Backend::Run, this);
+      fActive.store(true, std::memory_order_release);
+    }
+
+    void Stop()
+    {
+      if (!fThread.joinable()) return;
+      fActive.store(false, std::memory_order_release);
+      {
+        std::lock_guard<std::mutex> lock(fWakeMutex);
+        fStop = true;
+      }
+      fWake.notify_all();
+      fThread.join();
+      Drain();
+      if (fOutput != stdout) std::fclose(fOutput);
+      fOutput = stdout;
+    }
+
+    // Writes out every complete message; safe to call from any thread
+    size_t Drain()
+    {
+      std::lock_guard<std::mutex> drain_lock(fDrainMutex);
+      std::lock_guard<std::mutex> rings_lock(fRingsMutex);
+
+      size_t written = 0;
+      for (size_t i=0; i<fRings.size(); i++) {
+        RingBuffer* ring = fRings[i];
+        size_t tail = ring->fTail.load(std::memory_order_relaxed);
+        size_t head = ring->fHead.load(std::memory_order_acquire);
+        for (; tail != head; tail++) {
+          const RingBuffer::Slot& slot = ring->fSlots[tail % RingBuffer::kSlots];
+          std::fwrite(slot.text, 1, slot.length, fOutput);
+          std::fputc('\n', fOutput);
+          written++;
+        }
+        ring->fTail.store(tail, std::memory_order_release);
+
+        size_t dropped = ring->fDropped.exchange(0, std::memory_order_relaxed);
+        if (dropped)
+          std::fprintf(fOutput, "Log: %zu messages dropped (buffer full)\n", dropped);
+      }
+      if (written) std::fflush(fOutput);
+      return written;
+    }
+
+    bool Active() const { return fActive.load(std::memory_order_acquire); }
+
+  private:
+    void Run()
+    {
+      // Polls the rings instead of being signalled, so that producers
+      // never make a system call
+      std::unique_lock<std::mutex> lock(fWakeMutex);
+      while (!fStop) {
+        lock.unlock();
+        size_t written = Drain();
+        lock.lock();
+        if (!written)
+          fWake.wait_for(lock, std::chrono::milliseconds(1), [this]{ return fStop; });
+      }
+    }
+
+    std::atomic<bool> fActive;
+    bool fStop;
+    FILE* fOutput;
+    G4String fFileName;
+    std::thread fThread;
+    std::mutex fWakeMutex;
+    std::condition_variable fWake;
+    std::mutex fDrainMutex;
+    std::mutex fRingsMutex;
+    std::vector<RingBuffer*> fRings; // kept until exit: threads may log late
+  };
+
+
+  Backend& GetBackend()
+  {
+    static Backend backend;
+    return backend;
+  }
+
+
+  ThreadState& GetThreadState()
+  {
+    static thread_local ThreadState state;
+    return state;
+  }
+
+}
+
+
+void Log::Start()
+{
+  Backend& backend = GetBackend();
+  // No thread is needed when nothing is going to be logged
+  if (async && verbosity > kQuiet) backend.Start(file);
+  else backend.Stop();
+}
+
+
+void Log::Flush()
+{
+  Backend& backend = GetBackend();
+  if (backend.Active()) backend.Drain();
+}
+
+
+std::ostream& Log::Begin()
+{
+  if (!GetBackend().Active()) return G4cout;
+
+  ThreadState& state = GetThreadState();
+  if (!state.fRing) state.fRing = GetBackend().Register();
+
+  RingBuffer* ring = state.fRing;
+  size_t head = ring->fHead.load(std::memory_order_relaxed);
+  size_t tail = ring->fTail.load(std::memory_order_acquire);
+  state.fDropping = (head - tail >= RingBuffer::kSlots);
+
+  RingBuffer::Slot& slot =
+    state.fDropping ? state.fScratch : ring->fSlots[head % RingBuffer::kSlots];
+  state.fSlot = head;
+  state.fBuffer.Reset(slot.text, RingBuffer::kSlotSize);
+  state.fStream.clear();
+  return state.fStream;
+}
+
+
+void Log::End()
+{
+  if (!GetBackend().Active()) {
+    G4cout << G4endl;
+    return;
+  }
+
+  ThreadState& state = GetThreadState();
+  RingBuffer* ring = state.fRing;
+  if (state.fDropping) {
+    ring->fDropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  ring->fSlots[state.fSlot % RingBuffer::kSlots].length = state.fBuffer.Length();
+  ring->fHead.store(state.fSlot + 1, std::memory_order_release);
+}
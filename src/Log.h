@@ -0,0 +1,54 @@
+// -----------------------------------------------------------------------------
+//  G4Basic | Log.h
+//
+//  Verbosity-gated logging with an asynchronous backend. Messages above
+//  G4BASIC_LOG_MAX_LEVEL are compiled out, and messages above the current
+//  verbosity are not formatted at all. In asynchronous mode each thread
+//  formats its messages into its own lock-free ring buffer, which a
+//  background thread drains to stdout or to a log file; otherwise messages
+//  go synchronously to G4cout.
+//   * Author: Taylor Contreras, Justo Martin-Albo
+//   * Creation date: 18 Oct 2026
+// -----------------------------------------------------------------------------
+
+#ifndef LOG_H
+#define LOG_H
+
+#include "globals.hh"
+
+#include <ostream>
+
+#ifndef G4BASIC_LOG_MAX_LEVEL
+#define G4BASIC_LOG_MAX_LEVEL 2
+#endif
+
+namespace Log {
+
+  enum Level { kQuiet = 0, kInfo = 1, kDebug = 2 };
+
+  // Settings, through /G4Basic/run/
+  extern G4int verbosity;
+  extern G4bool async;   // read at Start()
+  extern G4String file;  // output of the asynchronous backend, or "none" for stdout
+
+  // Applies the settings: starts the background thread if asynchronous
+  // and verbosity is above quiet, otherwise stops it
+  void Start();
+  // Writes out all buffered messages before returning
+  void Flush();
+
+  // Used by G4BASIC_LOG: stream for one message, and its completion
+  std::ostream& Begin();
+  void End();
+
+}
+
+#define G4BASIC_LOG(level, message)                                  \
+  do {                                                               \
+    if ((level) <= G4BASIC_LOG_MAX_LEVEL && Log::verbosity >= (level)) { \
+      Log::Begin() << message;                                       \
+      Log::End();                                                    \
+    }                                                                \
+  } while (0)
+
+#endif
@@ -0,0 +1,117 @@
+// -----------------------------------------------------------------------------
+//  G4Basic | PhysicsList.cpp
+//
+//  Physics list with runtime-selectable profiles.
+//   * Author: Taylor Contreras, Justo Martin-Albo
+//   * Creation date: 18 Oct 2026
+// -----------------------------------------------------------------------------
+
+#include "PhysicsList.h"
+
+#include <G4GenericMessenger.hh>
+#include <G4EmStandardPhysics.hh>
+#include <G4EmStandardPhysics_option4.hh>
+#include <G4OpticalPhysics.hh>
+#include <G4RadioactiveDecayPhysics.hh>
+#include <G4StepLimiterPhysics.hh>
+#include <G4BosonConstructor.hh>
+#include <G4LeptonConstructor.hh>
+#include <G4MesonConstructor.hh>
+#include <G4BaryonConstructor.hh>
+#include <G4IonConstructor.hh>
+#include <G4ShortLivedConstructor.hh>
+#include <G4OpticalPhoton.hh>
+
+PhysicsList::PhysicsList()
+  : G4VUserPhysicsList(),
+    fMessenger(0),
+    fProfile("full"),
+    fCerenkov(true),
+    fScintillation(true),
+    fBoundary(true),
+    fAbsorption(true)
+{
+  // Physics settings are read in ConstructProcess(), so they must be
+  // given before /run/initialize.
+  fMessenger = new G4GenericMessenger(this, "/G4Basic/physics/",
+    "Selection of the physics used in the simulation.");
+
+  G4GenericMessenger::Command& profile_cmd =
+    fMessenger->DeclareMethod("profile", &PhysicsList::SetProfile,
+      "Physics profile: full (optics + EM opt4 + decay), "
+      "em (standard EM only) or decay (radioactive decay only).");
+  profile_cmd.SetCandidates("full em decay");
+  profile_cmd.SetStates(G4State_PreInit);
+
+  fMessenger->DeclareProperty("cerenkov", fCerenkov,
+    "Enable Cerenkov emission (full profile).")
+    .SetStates(G4State_PreInit);
+  fMessenger->DeclareProperty("scintillation", fScintillation,
+    "Enable scintillation (full profile).")
+    .SetStates(G4State_PreInit);
+  fMessenger->DeclareProperty("boundary", fBoundary,
+    "Enable optical boundary processes (full profile). "
+    "Without them no photon detection is recorded.")
+    .SetStates(G4State_PreInit);
+  fMessenger->DeclareProperty("absorption", fAbsorption,
+    "Enable bulk absorption of optical photons (full profile).")
+    .SetStates(G4State_PreInit);
+}
+
+
+PhysicsList::~PhysicsList()
+{
+  for (size_t i=0; i<fConstructors.size(); i++) delete fConstructors[i];
+  delete fMessenger;
+}
+
+
+void PhysicsList::SetProfile(const G4String& profile)
+{
+  fProfile = profile;
+}
+
+
+void PhysicsList::ConstructParticle()
+{
+  // This is called when the physics list is handed to the run manager,
+  // before any macro is read, so every particle that any profile may
+  // need is defined here. The profile only selects the processes.
+
+  G4BosonConstructor::ConstructParticle();
+  G4LeptonConstructor::ConstructParticle();
+  G4MesonConstructor::ConstructParticle();
+  G4BaryonConstructor::ConstructParticle();
+  G4IonConstructor::ConstructParticle();
+  G4ShortLivedConstructor::ConstructParticle();
+  G4OpticalPhoton::Definition();
+}
+
+
+void PhysicsList::ConstructProcess()
+{
+  AddTransportation();
+
+  if (fProfile == "full") {
+    G4OpticalPhysics* optical = new G4OpticalPhysics();
+    optical->Configure(kCerenkov,      fCerenkov);
+    optical->Configure(kScintillation, fScintillation);
+    optical->Configure(kBoundary,      fBoundary);
+    optical->Configure(kAbsorption,    fAbsorption);
+    fConstructors.push_back(optical);
+    fConstructors.push_back(new G4EmStandardPhysics_option4());
+    fConstructors.push_back(new G4RadioactiveDecayPhysics());
+  }
+  else if (fProfile == "em") {
+    fConstructors.push_back(new G4EmStandardPhysics());
+  }
+  else if (fProfile == "decay") {
+    fConstructors.push_back(new G4RadioactiveDecayPhysics());
+  }
+
+  // Needed for the maximum step lengths of the detector regions
+  fConstructors.push_back(new G4StepLimiterPhysics());
+
+  for (size_t i=0; i<fConstructors.size(); i++)
+    fConstructors[i]->ConstructProcess();
+}
@@ -0,0 +1,41 @@
+// -----------------------------------------------------------------------------
+//  G4Basic | PhysicsList.h
+//
+//  Physics list with runtime-selectable profiles.
+//   * Author: Taylor Contreras, Justo Martin-Albo
+//   * Creation date: 18 Oct 2026
+// -----------------------------------------------------------------------------
+
+#ifndef PHYSICS_LIST_H
+#define PHYSICS_LIST_H
+
+#include <G4VUserPhysicsList.hh>
+
+class G4VPhysicsConstructor;
+class G4GenericMessenger;
+
+
+class PhysicsList: public G4VUserPhysicsList
+{
+public:
+  PhysicsList();
+  virtual ~PhysicsList();
+  virtual void ConstructParticle();
+  virtual void ConstructProcess();
+
+private:
+  void SetProfile(const G4String& profile);
+
+  G4GenericMessenger* fMessenger;
+
+  G4String fProfile; // full, em or decay
+  G4bool fCerenkov;
+  G4bool fScintillation;
+  G4bool fBoundary;
+  G4bool fAbsorption;
+
+  // Physics constructors of the selected profile, built at initialization
+  std::vector<G4VPhysicsConstructor*> fConstructors;
+};
+
+#endif
@@ -7,19 +7,41 @@
 // -----------------------------------------------------------------------------
 
 #include "PrimaryGeneration.h"
+#include "VertexGenerator.h"
+#include "PrimaryReader.h"
+#include "DetectorConstruction.h"
 
 #include <G4ParticleDefinition.hh>
+#include <G4ParticleTable.hh>
 #include <G4SystemOfUnits.hh>
 #include <G4IonTable.hh>
 #include <G4PrimaryParticle.hh>
 #include <G4PrimaryVertex.hh>
 #include <G4Event.hh>
-#include <Randomize.hh>
+#include <G4RunManager.hh>
+#include <G4GenericMessenger.hh>
+
+#include <sstream>
 
 PrimaryGeneration::PrimaryGeneration(RunAction* runAction):
   G4VUserPrimaryGeneratorAction(),
   fParticleGun(0),
-  fRunAction(runAction)
+  fRunAction(runAction),
+  fGenerator(0),
+  fMessenger(0),
+  fReader(0),
+  fParticleName("gamma"),
+  fIonZ(0),
+  fIonA(0),
+  fIonExcitation(0.),
+  fSource("point"),
+  fPosition(0.,0.,0.),
+  fDirection(0.,0.,1.),
+  fIsotropic(false),
+  fEnergy(41.6*keV),
+  fSpectrumFile("none"),
+  fBatchSize(4096),
+  fInputFile("none")
 {
   G4int n_particle = 1;
   fParticleGun = new G4ParticleGun(n_particle);
@@ -27,56 +49,192 @@ PrimaryGeneration::PrimaryGeneration(RunAction* runAction):
   fParticleGun->SetParticleEnergy(0*eV);
   fParticleGun->SetParticlePosition(G4ThreeVector(0.,0.,0.));
   fParticleGun->SetParticleMomentumDirection(G4ThreeVector(0.,0.,0.));
+
+  fGenerator = new VertexGenerator();
+  fRunAction->SetPrimaryGeneration(this);
+
+  fMessenger = new G4GenericMessenger(this, "/G4Basic/generator/",
+    "Control of the primary generator. Settings take effect at the next run.");
+
+  fMessenger->DeclareProperty("particle", fParticleName,
+    "Name of the primary particle (ion for the one set by ionZ and ionA).");
+  // G4GenericMessenger passes a single word to methods, so the ion is given
+  // through three commands, e.g. ionZ 36, ionA 83, ionExcitation 41.6 keV
+  // for Kr-83m
+  fMessenger->DeclareMethod("ionZ", &PrimaryGeneration::SetIonZ,
+    "Atomic number of the primary ion. Selects the ion as primary, "
+    "at rest: resets the kinetic energy to 0.");
+  fMessenger->DeclareMethod("ionA", &PrimaryGeneration::SetIonA,
+    "Mass number of the primary ion.");
+  fMessenger->DeclarePropertyWithUnit("ionExcitation", "keV", fIonExcitation,
+    "Excitation energy of the primary ion.");
+  fMessenger->DeclareProperty("source", fSource,
+    "Vertex source: point, volume (GXe chamber) or surface (chamber walls).")
+    .SetCandidates("point volume surface");
+  fMessenger->DeclarePropertyWithUnit("position", "cm", fPosition,
+    "Vertex position of the point source.");
+  fMessenger->DeclareProperty("direction", fDirection,
+    "Momentum direction of the primary (if not isotropic).");
+  fMessenger->DeclareProperty("isotropic", fIsotropic,
+    "Generate isotropic momentum directions.");
+  fMessenger->DeclarePropertyWithUnit("energy", "keV", fEnergy,
+    "Kinetic energy of the primary.");
+  fMessenger->DeclareProperty("spectrum", fSpectrumFile,
+    "File of \"energy[keV] weight\" lines to sample the energy from "
+    "(none to use the fixed energy).");
+  fMessenger->DeclareProperty("batchSize", fBatchSize,
+    "Number of vertices pre-sampled at once.");
+  fMessenger->DeclareProperty("inputFile", fInputFile,
+    "Read primary events from a text (HEPEvt-style) or binary file "
+    "instead of using the particle gun (none to use the gun).");
 }
 
 
 PrimaryGeneration::~PrimaryGeneration()
 {
+  delete fMessenger;
+  delete fReader;
+  delete fGenerator;
   delete fParticleGun;
 }
 
 
-void PrimaryGeneration::GeneratePrimaries(G4Event* event)
+void PrimaryGeneration::SetIonZ(G4int z)
 {
-  /*
-  G4int Z = 36;
-  G4int A = 83;
-  G4double exitEnergy = 41.6*keV;
-
-  // Make Krypton 83 decay
-  G4ParticleDefinition* particle_definition = G4IonTable::GetIonTable()->
-    GetIon(Z, A, exitEnergy);
-
-  // Generate random position within a cylinder
-  G4double det_r = 0.5*m; // radius of Xenon chamber
-  G4double det_z = 1.*m; // length of Xenon chamger
-  // FIXME: should make this automatic based on DetectorConstruction..
-  G4double rand = G4UniformRand(); // random number between 0 and 1
-  G4double rand_phi = G4UniformRand()*2.*CLHEP::pi;
-  G4double rand_r = det_r*std::sqrt(rand);
-  G4double rand_x = rand_r*cos(rand_phi);
-  G4double rand_y = rand_r*sin(rand_phi);
-  G4double rand_z = (G4UniformRand()-0.5)*det_z;
-
-  fParticleGun->SetParticleDefinition(particle_definition);
-  fParticleGun->SetParticlePosition(G4ThreeVector(rand_x, rand_y, rand_z));
-  fParticleGun->GeneratePrimaryVertex(event);
-  */
-
-  /////////////////////////////////////////////////////////////////////////////
-  // Testing with single photon
-  /////////////////////////////////////////////////////////////////////////////
-  G4ParticleTable* particleTable = G4ParticleTable::GetParticleTable();
-  G4String particleName;
-  G4ParticleDefinition* particle = particleTable->FindParticle(22);
+  if (z < 1)
+    G4Exception("PrimaryGeneration::SetIonZ()", "[PrimaryGeneration]",
+                FatalErrorInArgument, "the atomic number of an ion must be at least 1");
+  fIonZ = z;
+  fParticleName = "ion";
+  fEnergy = 0.; // decays at rest, unless an energy is given afterwards
+}
+
+
+void PrimaryGeneration::SetIonA(G4int a)
+{
+  if (a < 1)
+    G4Exception("PrimaryGeneration::SetIonA()", "[PrimaryGeneration]",
+                FatalErrorInArgument, "the mass number of an ion must be at least 1");
+  fIonA = a;
+}
+
+
+void PrimaryGeneration::BeginOfRun()
+{
+  // An input file keeps streaming across runs until it is changed
+  if (fInputFile == "none") {
+    delete fReader;
+    fReader = 0;
+  }
+  else if (!fReader || fReader->GetFileName() != fInputFile) {
+    delete fReader;
+    fReader = new PrimaryReader(fInputFile);
+  }
+  if (fReader) return;
+
+  // Particle definitions are looked up once per run, not per event.
+  // Ions can only be built once physics is initialized, hence here.
+
+  G4ParticleDefinition* particle = 0;
+  if (fParticleName == "ion") {
+    if (fIonZ < 1 || fIonA < fIonZ)
+      G4Exception("PrimaryGeneration::BeginOfRun()", "[PrimaryGeneration]",
+                  FatalErrorInArgument, "ion primary without a valid ionZ and ionA");
+    particle = G4IonTable::GetIonTable()->GetIon(fIonZ, fIonA, fIonExcitation);
+  }
+  else
+    particle = G4ParticleTable::GetParticleTable()->FindParticle(fParticleName);
+
+  if (!particle)
+    G4Exception("PrimaryGeneration::BeginOfRun()", "[PrimaryGeneration]",
+                FatalException, ("unknown particle " + fParticleName).c_str());
+
   fParticleGun->SetParticleDefinition(particle);
 
-  fParticleGun->SetParticlePosition(G4ThreeVector(0, 0, 0));
-  fParticleGun->SetParticleMomentumDirection(G4ThreeVector(0,0,1));
-  fParticleGun->SetParticleEnergy(41.6*keV);
-  fParticleGun->GeneratePrimaryVertex(event);
+  const DetectorConstruction* detectorConstruction
+    = static_cast<const DetectorConstruction*>
+    ( G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+
+  fGenerator->SetChamber(detectorConstruction->GetChamberRadius(),
+                         detectorConstruction->GetChamberLength());
+  fGenerator->SetSource(fSource);
+  fGenerator->SetPoint(fPosition);
+  fGenerator->SetDirection(fDirection);
+  fGenerator->SetIsotropic(fIsotropic);
+  if (fSpectrumFile == "none") fGenerator->SetEnergy(fEnergy);
+  else fGenerator->LoadSpectrum(fSpectrumFile);
+  fGenerator->SetBatchSize(fBatchSize);
+  fGenerator->Reset();
+}
+
 
+void PrimaryGeneration::GeneratePrimaries(G4Event* event)
+{
   G4int eventid = event->GetEventID();
-  //fRunAction->FillInitials(rand_x, rand_y, rand_z, eventid);
-  //G4cout << "\n\n"<<rand_x<<" "<<rand_y<<" "<<rand_z <<"\n\n"<<G4endl;
+
+  if (fReader) {
+    GenerateFromInput(event);
+    return;
+  }
+
+  G4ThreeVector position, direction;
+  G4double energy;
+  fGenerator->Next(position, direction, energy);
+
+  fParticleGun->SetParticlePosition(position);
+  fParticleGun->SetParticleMomentumDirection(direction);
+  fParticleGun->SetParticleEnergy(energy);
+  fParticleGun->GeneratePrimaryVertex(event);
+
+  fRunAction->FillInitials(position.x(), position.y(), position.z(), eventid);
+}
+
+
+void PrimaryGeneration::GenerateFromInput(G4Event* event)
+{
+  PrimaryReader::Event input;
+  if (!fReader->Next(input)) {
+    // The event is left without vertices, so EventAction does not record
+    // it; the soft abort stops the run after it.
+    G4Exception("PrimaryGeneration::GenerateFromInput()", "[PrimaryGeneration]",
+                JustWarning, "end of input file reached, aborting run");
+    G4RunManager::GetRunManager()->AbortRun(true);
+    return;
+  }
+
+  G4PrimaryVertex* vertex =
+    new G4PrimaryVertex(G4ThreeVector(input.x, input.y, input.z), input.t);
+
+  for (size_t i=0; i<input.particles.size(); i++) {
+    const PrimaryReader::Particle& p = input.particles[i];
+    G4ParticleDefinition* definition = FindDefinition(p.pdg);
+    if (!definition) continue;
+    vertex->SetPrimary(new G4PrimaryParticle(definition, p.px, p.py, p.pz));
+  }
+
+  event->AddPrimaryVertex(vertex);
+
+  fRunAction->FillInitials(input.x, input.y, input.z, event->GetEventID());
+}
+
+
+G4ParticleDefinition* PrimaryGeneration::FindDefinition(G4int pdg)
+{
+  std::map<G4int, G4ParticleDefinition*>::iterator it = fDefinitions.find(pdg);
+  if (it != fDefinitions.end()) return it->second;
+
+  G4ParticleDefinition* definition =
+    G4ParticleTable::GetParticleTable()->FindParticle(pdg);
+  if (!definition && pdg > 1000000000)
+    definition = G4IonTable::GetIonTable()->GetIon(pdg);
+
+  if (!definition) {
+    std::ostringstream msg;
+    msg << "unknown PDG code " << pdg << " in input file, particle skipped";
+    G4Exception("PrimaryGeneration::FindDefinition()", "[PrimaryGeneration]",
+                JustWarning, msg.str().c_str());
+  }
+
+  fDefinitions[pdg] = definition;
+  return definition;
 }
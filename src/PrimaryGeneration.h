@@ -16,6 +16,9 @@
 #include "globals.hh"
 
 class G4ParticleDefinition;
+class G4GenericMessenger;
+class VertexGenerator;
+class PrimaryReader;
 
 
 class PrimaryGeneration: public G4VUserPrimaryGeneratorAction
@@ -26,9 +29,35 @@ public:
   virtual void GeneratePrimaries(G4Event*);
   G4ParticleGun* GetParticleGun() { return fParticleGun;};
 
+  // Applies the generator settings; called by RunAction at run start
+  void BeginOfRun();
+
  private:
+  void SetIonZ(G4int z);
+  void SetIonA(G4int a);
+  void GenerateFromInput(G4Event* event);
+  G4ParticleDefinition* FindDefinition(G4int pdg);
+
   G4ParticleGun* fParticleGun;
   RunAction* fRunAction;
+  VertexGenerator* fGenerator;
+  G4GenericMessenger* fMessenger;
+  PrimaryReader* fReader;
+  std::map<G4int, G4ParticleDefinition*> fDefinitions; // by PDG code
+
+  // Generator settings, applied at the start of each run
+  G4String fParticleName; // particle table name, or "ion"
+  G4int fIonZ;
+  G4int fIonA;
+  G4double fIonExcitation;
+  G4String fSource;       // point, volume or surface
+  G4ThreeVector fPosition;
+  G4ThreeVector fDirection;
+  G4bool fIsotropic;
+  G4double fEnergy;
+  G4String fSpectrumFile; // overrides fEnergy unless "none"
+  G4int fBatchSize;
+  G4String fInputFile;    // pre-generated events, replaces the gun unless "none"
 };
 
 #endif
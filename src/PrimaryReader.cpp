@@ -0,0 +1,256 @@
+// -----------------------------------------------------------------------------
+//  G4Basic | PrimaryReader.cpp
+//
+//  Streaming reader of pre-generated primary events.
+//   * Author: Taylor Contreras, Justo Martin-Albo
+//   * Creation date: 18 Oct 2026
+// -----------------------------------------------------------------------------
+
+#include "PrimaryReader.h"
+
+#include <G4SystemOfUnits.hh>
+#include <G4Exception.hh>
+
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+  const char kBinaryMagic[8] = {'G','4','B','P','R','I','M','1'};
+}
+
+
+PrimaryReader::PrimaryReader(const G4String& filename, size_t chunk_size)
+  : fFileName(filename),
+    fFileDescriptor(-1),
+    fData(0),
+    fFileSize(0),
+    fOffset(0),
+    fBinary(false),
+    fChunkSize(chunk_size > 0 ? chunk_size : 1),
+    fMaxChunks(2),
+    fCurrentIndex(0),
+    fDone(false),
+    fStop(false)
+{
+  fFileDescriptor = open(filename.c_str(), O_RDONLY);
+  struct stat info;
+  if (fFileDescriptor < 0 || fstat(fFileDescriptor, &info) != 0)
+    G4Exception("PrimaryReader::PrimaryReader()", "[PrimaryReader]",
+                FatalException, ("cannot open input file " + filename).c_str());
+
+  fFileSize = info.st_size;
+  if (fFileSize > 0) {
+    void* data = mmap(0, fFileSize, PROT_READ, MAP_PRIVATE, fFileDescriptor, 0);
+    if (data == MAP_FAILED)
+      G4Exception("PrimaryReader::PrimaryReader()", "[PrimaryReader]",
+                  FatalException, ("cannot map input file " + filename).c_str());
+    fData = static_cast<const char*>(data);
+    madvise(data, fFileSize, MADV_SEQUENTIAL);
+  }
+
+  if (fFileSize >= sizeof(kBinaryMagic) &&
+      std::memcmp(fData, kBinaryMagic, sizeof(kBinaryMagic)) == 0) {
+    fBinary = true;
+    fOffset = sizeof(kBinaryMagic);
+  }
+
+  fThread = std::thread(&PrimaryReader::Decode, this);
+}
+
+
+PrimaryReader::~PrimaryReader()
+{
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fStop = true;
+  }
+  fCondition.notify_all();
+  fThread.join();
+
+  if (fData) munmap(const_cast<char*>(fData), fFileSize);
+  if (fFileDescriptor >= 0) close(fFileDescriptor);
+}
+
+
+G4bool PrimaryReader::Next(Event& event)
+{
+  if (fCurrentIndex >= fCurrent.size()) {
+    std::unique_lock<std::mutex> lock(fMutex);
+    fCondition.wait(lock, [this]{ return !fQueue.empty() || fDone; });
+
+    if (fQueue.empty()) {
+      if (!fError.empty())
+        G4Exception("PrimaryReader::Next()", "[PrimaryReader]",
+                    FatalException, (fFileName + ": " + fError).c_str());
+      return false;
+    }
+
+    fCurrent.swap(fQueue.front());
+    fQueue.pop_front();
+    fCurrentIndex = 0;
+    lock.unlock();
+    fCondition.notify_all();
+  }
+
+  event = std::move(fCurrent[fCurrentIndex++]);
+  return true;
+}
+
+
+void PrimaryReader::Decode()
+{
+  while (true) {
+    std::vector<Event> chunk;
+    chunk.reserve(fChunkSize);
+
+    Event event;
+    while (chunk.size() < fChunkSize &&
+           (fBinary ? DecodeBinary(event) : DecodeText(event)))
+      chunk.push_back(std::move(event));
+
+    // A short (or empty) chunk means the input is exhausted
+    bool exhausted = chunk.size() < fChunkSize;
+
+    std::unique_lock<std::mutex> lock(fMutex);
+    fCondition.wait(lock, [this]{ return fQueue.size() < fMaxChunks || fStop; });
+    if (fStop) return;
+
+    if (!chunk.empty()) fQueue.push_back(std::move(chunk));
+    if (exhausted) {
+      fDone = true;
+      lock.unlock();
+      fCondition.notify_all();
+      return;
+    }
+    lock.unlock();
+    fCondition.notify_all();
+  }
+}
+
+
+bool PrimaryReader::NextLine(std::string& line)
+{
+  // Copies the next non-comment line, so that the number parsing below
+  // never runs past the end of the mapped file
+  while (fOffset < fFileSize) {
+    const char* begin = fData + fOffset;
+    const char* end = static_cast<const char*>
+      (std::memchr(begin, '\n', fFileSize - fOffset));
+    if (!end) end = fData + fFileSize;
+    fOffset = end - fData + 1;
+
+    line.assign(begin, end);
+    size_t first = line.find_first_not_of(" \t\r");
+    if (first == std::string::npos || line[first] == '#') continue;
+    return true;
+  }
+  return false;
+}
+
+
+bool PrimaryReader::DecodeText(Event& event)
+{
+  std::string line;
+  if (!NextLine(line)) return false;
+
+  char* pos = const_cast<char*>(line.c_str());
+  char* next;
+  long nhep = std::strtol(pos, &next, 10);
+  if (next == pos || nhep < 0) {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fError = "bad event header: " + line;
+    return false;
+  }
+  pos = next;
+  G4double vertex[4] = {0., 0., 0., 0.};
+  for (int i=0; i<4; i++) {
+    vertex[i] = std::strtod(pos, &next);
+    if (next == pos) break;
+    pos = next;
+  }
+  event.x = vertex[0]*mm;
+  event.y = vertex[1]*mm;
+  event.z = vertex[2]*mm;
+  event.t = vertex[3]*ns;
+
+  event.particles.clear();
+  for (long i=0; i<nhep; i++) {
+    if (!NextLine(line)) {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fError = "unexpected end of file inside an event";
+      return false;
+    }
+    pos = const_cast<char*>(line.c_str());
+    long isthep = std::strtol(pos, &pos, 10);
+    long idhep  = std::strtol(pos, &pos, 10);
+    std::strtol(pos, &pos, 10); // JDAHEP1
+    std::strtol(pos, &pos, 10); // JDAHEP2
+    G4double px = std::strtod(pos, &pos);
+    G4double py = std::strtod(pos, &pos);
+    G4double pz = std::strtod(pos, &pos);
+    if (isthep != 1) continue;
+
+    Particle particle;
+    particle.pdg = idhep;
+    particle.px = px*GeV;
+    particle.py = py*GeV;
+    particle.pz = pz*GeV;
+    event.particles.push_back(particle);
+  }
+
+  return true;
+}
+
+
+bool PrimaryReader::DecodeBinary(Event& event)
+{
+  const size_t header_size = sizeof(uint32_t) + 4*sizeof(double);
+  const size_t particle_size = sizeof(int32_t) + 3*sizeof(double);
+
+  if (fOffset >= fFileSize) return false;
+  if (fFileSize - fOffset < header_size) {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fError = "truncated event header";
+    return false;
+  }
+
+  const char* pos = fData + fOffset;
+  uint32_t n;
+  double vertex[4];
+  std::memcpy(&n, pos, sizeof(n));
+  std::memcpy(vertex, pos + sizeof(n), sizeof(vertex));
+  pos += header_size;
+
+  if ((fFileSize - (pos - fData))/particle_size < n) {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fError = "truncated event";
+    return false;
+  }
+
+  event.x = vertex[0]*mm;
+  event.y = vertex[1]*mm;
+  event.z = vertex[2]*mm;
+  event.t = vertex[3]*ns;
+
+  event.particles.resize(n);
+  for (uint32_t i=0; i<n; i++) {
+    int32_t pdg;
+    double p[3];
+    std::memcpy(&pdg, pos, sizeof(pdg));
+    std::memcpy(p, pos + sizeof(pdg), sizeof(p));
+    pos += particle_size;
+
+    event.particles[i].pdg = pdg;
+    event.particles[i].px = p[0]*MeV;
+    event.particles[i].py = p[1]*MeV;
+    event.particles[i].pz = p[2]*MeV;
+  }
+
+  fOffset = pos - fData;
+  return true;
+}
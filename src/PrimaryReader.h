@@ -0,0 +1,89 @@
+// -----------------------------------------------------------------------------
+//  G4Basic | PrimaryReader.h
+//
+//  Streaming reader of pre-generated primary events. The input file is
+//  memory-mapped and decoded in chunks by a background thread, so that the
+//  next events are ready while the current ones are being tracked.
+//
+//  Two formats are accepted, distinguished by the first 8 bytes of the file:
+//
+//  * Text (HEPEvt-style), one block per event:
+//      NHEP [X Y Z [T]]
+//      ISTHEP IDHEP JDAHEP1 JDAHEP2 PHEP1 PHEP2 PHEP3 PHEP5   (NHEP lines)
+//    as read by G4HEPEvtInterface (momenta and mass in GeV), plus an optional
+//    vertex position [mm] and time [ns] on the header line (default 0).
+//    Only entries with ISTHEP == 1 are used. Lines starting with '#' are
+//    comments.
+//
+//  * Binary, little-endian and packed, starting with the magic "G4BPRIM1":
+//      uint32 N; float64 X, Y, Z [mm], T [ns]            (per event)
+//      int32 PDG; float64 PX, PY, PZ [MeV]               (N times)
+//
+//   * Author: Taylor Contreras, Justo Martin-Albo
+//   * Creation date: 18 Oct 2026
+// -----------------------------------------------------------------------------
+
+#ifndef PRIMARY_READER_H
+#define PRIMARY_READER_H
+
+#include "globals.hh"
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+
+class PrimaryReader
+{
+public:
+  struct Particle {
+    G4int pdg;
+    G4double px, py, pz; // MeV
+  };
+
+  struct Event {
+    G4double x, y, z; // mm
+    G4double t;       // ns
+    std::vector<Particle> particles;
+  };
+
+  PrimaryReader(const G4String& filename, size_t chunk_size = 1000);
+  ~PrimaryReader();
+
+  const G4String& GetFileName() const { return fFileName; }
+
+  // Moves the next event into the argument; returns false at end of input
+  G4bool Next(Event& event);
+
+private:
+  void Decode(); // background thread
+  bool DecodeText(Event& event);
+  bool DecodeBinary(Event& event);
+  bool NextLine(std::string& line);
+
+  G4String fFileName;
+  int fFileDescriptor;
+  const char* fData;
+  size_t fFileSize;
+  size_t fOffset; // decoding position, only touched by the thread
+  bool fBinary;
+
+  // Chunks of decoded events, at most fMaxChunks ahead of the consumer
+  size_t fChunkSize;
+  size_t fMaxChunks;
+  std::deque<std::vector<Event> > fQueue;
+  std::vector<Event> fCurrent;
+  size_t fCurrentIndex;
+
+  std::mutex fMutex;
+  std::condition_variable fCondition;
+  bool fDone;
+  bool fStop;
+  std::string fError; // decoding error, reported on the consumer side
+  std::thread fThread;
+};
+
+#endif
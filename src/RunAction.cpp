@@ -7,6 +7,9 @@
 // -----------------------------------------------------------------------------
 
 #include "RunAction.h"
+#include "Telemetry.h"
+#include "PrimaryGeneration.h"
+#include "Log.h"
 
 #include "TFile.h"
 #include "TTree.h"
@@ -14,6 +17,8 @@
 
 #include <G4SystemOfUnits.hh>
 #include <G4AccumulableManager.hh>
+#include <G4Run.hh>
+#include <G4GenericMessenger.hh>
 #include <string.h>
 #include <iostream>
 using namespace std;
@@ -21,8 +26,27 @@ using namespace std;
 RunAction::RunAction()
   : G4UserRunAction(),
     fEdep(0.),
-    feventnum(0)
+    feventnum(0),
+    fFirstRun(true),
+    fTelemetry(0),
+    fPrimaryGeneration(0),
+    fMessenger(0)
 {
+  fTimer.Start();
+
+  fTelemetry = new Telemetry();
+  fTelemetry->SetOutputFile("MyFile.root");
+
+  fMessenger = new G4GenericMessenger(this, "/G4Basic/run/", "Run control.");
+  fMessenger->DeclareProperty("verbose", Log::verbosity,
+    "Verbosity of the event and stepping actions: "
+    "0 quiet, 1 per-event messages, 2 per-step messages.");
+  fMessenger->DeclareProperty("asyncLog", Log::async,
+    "Buffer log messages and write them from a background thread "
+    "(bypasses G4cout, so disable it in interactive sessions).");
+  fMessenger->DeclareProperty("logFile", Log::file,
+    "Output of the asynchronous log (none for stdout).");
+
   // Register accumulable to the accumulable manager
   G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
   accumulableManager->RegisterAccumulable(fEdep);
@@ -31,17 +55,37 @@ RunAction::RunAction()
 
 RunAction::~RunAction()
 {
+  delete fMessenger;
+  delete fTelemetry;
 }
 
 
-void RunAction::BeginOfRunAction(const G4Run*)
+void RunAction::BeginOfRunAction(const G4Run* run)
 {
+  // Physics tables are built just before the first run starts, so the
+  // time elapsed until then is the initialization time of the job.
+  if (fFirstRun) {
+    fTimer.Stop();
+    G4cout << "Initialization time: " << fTimer.GetRealElapsed() << " s" << G4endl;
+    fFirstRun = false;
+  }
+  fTimer.Start();
+  Log::Start();
+  if (fPrimaryGeneration) fPrimaryGeneration->BeginOfRun();
+  fTelemetry->BeginOfRun(run->GetNumberOfEventToBeProcessed());
 }
 
 
-void RunAction::EndOfRunAction(const G4Run*){
+void RunAction::EndOfRunAction(const G4Run* run){
   // Make and fill output file with information from the run
 
+  fTimer.Stop();
+  Log::Flush();
+  G4int nevents = run->GetNumberOfEvent();
+  G4double run_time = fTimer.GetRealElapsed();
+  G4cout << "Run time: " << run_time << " s, "
+         << (run_time > 0. ? nevents/run_time : 0.) << " events/s" << G4endl;
+
   int numevents = fEdepMap.size();
   int numtracks = fxfinMap[0].size();
   
@@ -64,6 +108,19 @@ void RunAction::EndOfRunAction(const G4Run*){
   tree2->Branch("ndpos", &dpos, "dpos/F");
   tree2->Branch("nevent", &eventid, "eventid/I");
 
+  // Per-event resource accounting, if enabled
+  EventAccounting accounting;
+  if (!fAccountingMap.empty()) {
+    tree1->Branch("nwalltime", &accounting.walltime, "walltime/F");
+    tree1->Branch("nsteps", &accounting.nsteps, "nsteps/I");
+    tree1->Branch("nopticals", &accounting.nopticals, "nopticals/I");
+    tree1->Branch("ngammas", &accounting.ngammas, "ngammas/I");
+    tree1->Branch("nelectrons", &accounting.nelectrons, "nelectrons/I");
+    tree1->Branch("nothers", &accounting.nothers, "nothers/I");
+    tree1->Branch("npeakheap", &accounting.peakheap, "peakheap/F");
+    tree1->Branch("nwatchdog", &accounting.watchdog, "watchdog/I");
+  }
+
   for (int i=0; i<numevents; i++){
     // Fill initial info and total edep from event
 
@@ -73,6 +130,7 @@ void RunAction::EndOfRunAction(const G4Run*){
     yinit = fyinitMap[i]/cm;
     zinit = fzinitMap[i]/cm;
     eventid = feventids[i];
+    accounting = fAccountingMap[i];
 
     numtracks = fxfinMap[i].size();
     //G4cout <<"Size: "<<size << G4endl;
@@ -96,6 +154,8 @@ void RunAction::EndOfRunAction(const G4Run*){
   }
 
   MyFile->Write();
+
+  fTelemetry->EndOfRun();
 }
 
 void RunAction::AddEdep(G4double edep){
@@ -125,3 +185,8 @@ void RunAction::FillFinals(G4double x, G4double y, G4double z, G4int pid, G4int
   ftrackMap[feventnum][trackid] = trackid;
   //G4cout << "\nFilling Final Maps:" << fxfinMap[feventnum][trackid] <<" "<<trackid<<"\n"<< G4endl;
 }
+
+void RunAction::FillAccounting(const EventAccounting& accounting){
+
+  fAccountingMap[feventnum] = accounting;
+}
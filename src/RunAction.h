@@ -11,6 +11,24 @@
 
 #include <G4UserRunAction.hh>
 #include "G4Accumulable.hh"
+#include "G4Timer.hh"
+
+class Telemetry;
+class PrimaryGeneration;
+class G4GenericMessenger;
+
+// Resources used by one event (see EventAction)
+struct EventAccounting
+{
+  float walltime;  // ms
+  int nsteps;
+  int nopticals;   // tracks by particle type
+  int ngammas;
+  int nelectrons;
+  int nothers;
+  float peakheap;  // MB of heap growth over the event (see HeapAccounting)
+  int watchdog;    // 0 within budget, 1 flagged, 2 killed
+};
 
 class RunAction: public G4UserRunAction
 {
@@ -23,12 +41,20 @@ public:
   void AddEdep (G4double edep);
   void FillInitials (G4double x, G4double y, G4double z, G4int eventid);
   void FillFinals (G4double x, G4double y, G4double z, G4int pid, G4int trackid);
+  void FillAccounting (const EventAccounting& accounting);
   void NextEvent () {feventnum++;}
   int EventNum () {return feventnum;}
+  Telemetry* GetTelemetry () {return fTelemetry;}
+  void SetPrimaryGeneration (PrimaryGeneration* generation) {fPrimaryGeneration = generation;}
   
  private:
   G4Accumulable<G4double> fEdep;
   int feventnum;
+  G4Timer fTimer; // initialization, then run wall time
+  G4bool fFirstRun;
+  Telemetry* fTelemetry;
+  PrimaryGeneration* fPrimaryGeneration;
+  G4GenericMessenger* fMessenger;
   std::map<int, float> fEdepMap;
   std::map<int, float> fxinitMap;
   std::map<int,float> fyinitMap;
@@ -39,6 +65,7 @@ public:
   std::map<int,std::map<int,float>> fzfinMap;
   std::map<int,std::map<int,int>> fpidMap;
   std::map<int,std::map<int,int>> ftrackMap;
+  std::map<int, EventAccounting> fAccountingMap;
 };
 
 #endif
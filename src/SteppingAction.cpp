@@ -9,6 +9,7 @@
 #include "SteppingAction.h"
 #include "DetectorConstruction.h"
 #include "RunAction.h"
+#include "Log.h"
 
 #include "G4Step.hh"
 #include "G4StepStatus.hh"
@@ -17,13 +18,16 @@
 #include "G4RunManager.hh"
 #include "G4OpticalPhoton.hh"
 #include "G4OpBoundaryProcess.hh"
+#include "G4Region.hh"
 
-SteppingAction::SteppingAction(EventAction* eventAction, RunAction* runAction):
+SteppingAction::SteppingAction(EventAction* eventAction, RunAction* runAction,
+                               TrackingAction* trackingAction):
   G4UserSteppingAction(),
   fEventAction(eventAction),
   fEnergyPlane(0),
   fTrackingPlane(0),
   fRunAction(runAction),
+  fTrackingAction(trackingAction),
   fboundary(0)
 {
 }
@@ -52,6 +56,22 @@ void SteppingAction::UserSteppingAction(const G4Step* step)
 
   G4double edepStep = step->GetTotalEnergyDeposit();
   fEventAction->AddEdep(edepStep);
+  fEventAction->AddStep();
+  fTrackingAction->AppendStep();
+
+  // Kill particles entering a region flagged as kill-on-entry. The post-step
+  // volume of an optical photon at a boundary is the next volume even if the
+  // boundary process reflects it, so photons must also have been transmitted.
+  const G4StepPoint* post_point = step->GetPostStepPoint();
+  if (post_point->GetStepStatus() == fGeomBoundary && track->GetNextVolume()) {
+    const G4Region* next_region =
+      track->GetNextVolume()->GetLogicalVolume()->GetRegion();
+    if (next_region != volume->GetRegion() &&
+        detectorConstruction->KillOnEntry(next_region) &&
+        (track->GetDefinition() != G4OpticalPhoton::Definition() ||
+         Transmitted()))
+      track->SetTrackStatus(fStopAndKill);
+  }
 
   std::map<int, int> TrackMap = fEventAction->GetTrackMap();
   G4TrackStatus status = track->GetTrackStatus();
@@ -82,28 +102,44 @@ void SteppingAction::UserSteppingAction(const G4Step* step)
   // Only do this once per run
   //static G4OpBoundaryProcess* boundary = 0;
 
-  if (!fboundary) { //pointer is not defined yet
-    // Get list of processes defined for optical photon
-    // and loop through it to find optical boundary process
-    G4ProcessVector* pv = pdef->GetProcessManager()->GetProcessList();
-    for (G4int i=0; i<pv->size(); i++){
-      if ((*pv)[i]->GetProcessName() == "OpBoundary"){
-	  fboundary = (G4OpBoundaryProcess*) (*pv)[i];
-	  break;
-      }
-    }
-  }
+  if (!fboundary) FindBoundaryProcess(); //pointer is not defined yet
 
   // Note: fGeomBoundary is the current volume
   G4StepStatus stat = step->GetPostStepPoint()->GetStepStatus();
-  G4cout << "volume: "<< volume->GetName()<<"\n"<<G4endl;
-  if (stat == fGeomBoundary){
+  G4BASIC_LOG(Log::kDebug, "volume: "<< volume->GetName()<<"\n");
+  // No detection without the boundary process (/G4Basic/physics/boundary false)
+  if (stat == fGeomBoundary && fboundary){
     //G4cout << "status: "<<fboundary->GetStatus()<<"\n" << G4endl;
     if (fboundary->GetStatus() == Detection){
       G4String detector_name = step->GetPostStepPoint()->GetTouchableHandle()->GetVolume()->GetName();
-      G4cout << "##### Sensitive Volume: " << detector_name <<G4endl;
+      G4BASIC_LOG(Log::kDebug, "##### Sensitive Volume: " << detector_name);
     }
   }
 
   return;
 }
+
+
+void SteppingAction::FindBoundaryProcess()
+{
+  // Get list of processes defined for optical photon
+  // and loop through it to find optical boundary process
+  G4ProcessVector* pv =
+    G4OpticalPhoton::Definition()->GetProcessManager()->GetProcessList();
+  for (G4int i=0; i<pv->size(); i++){
+    if ((*pv)[i]->GetProcessName() == "OpBoundary"){
+      fboundary = (G4OpBoundaryProcess*) (*pv)[i];
+      break;
+    }
+  }
+}
+
+
+G4bool SteppingAction::Transmitted()
+{
+  if (!fboundary) FindBoundaryProcess();
+  // Without the boundary process photons cross every surface unaltered
+  if (!fboundary) return true;
+  G4OpBoundaryProcessStatus status = fboundary->GetStatus();
+  return status == FresnelRefraction || status == Transmission;
+}
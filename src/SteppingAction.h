@@ -11,6 +11,7 @@
 
 #include "EventAction.h"
 #include "RunAction.h"
+#include "TrackingAction.h"
 
 #include "TFile.h"
 #include "TH1F.h"
@@ -22,13 +23,19 @@
 class SteppingAction: public G4UserSteppingAction
 {
   public:
-  SteppingAction(EventAction* eventAction, RunAction* runAction);
+  SteppingAction(EventAction* eventAction, RunAction* runAction,
+                 TrackingAction* trackingAction);
     virtual ~SteppingAction();
     virtual void UserSteppingAction(const G4Step*);
 
  private:    
+    void FindBoundaryProcess();
+    // Whether the optical photon of the step crossed the boundary
+    G4bool Transmitted();
+
     EventAction* fEventAction;
     RunAction* fRunAction;
+    TrackingAction* fTrackingAction;
     G4LogicalVolume* fEnergyPlane;
     G4LogicalVolume* fTrackingPlane;
     G4OpBoundaryProcess* fboundary;
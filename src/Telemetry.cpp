@@ -0,0 +1,174 @@
+// -----------------------------------------------------------------------------
+//  G4Basic | Telemetry.cpp
+//
+//  Rate-limited progress reporting of a run.
+//   * Author: Taylor Contreras, Justo Martin-Albo
+//   * Creation date: 18 Oct 2026
+// -----------------------------------------------------------------------------
+
+#include "Telemetry.h"
+
+#include <G4GenericMessenger.hh>
+#include <G4ios.hh>
+
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+#include <sys/stat.h>
+
+Telemetry::Telemetry()
+  : fMessenger(0),
+    fEnabled(true),
+    fInterval(10.),
+    fMetricsFile("G4Basic.prom"),
+    fOutputFile(""),
+    fEventsToProcess(0),
+    fEvents(0),
+    fSteps(0.)
+{
+  fMessenger = new G4GenericMessenger(this, "/G4Basic/telemetry/",
+    "Periodic reporting of the run progress.");
+
+  fMessenger->DeclareProperty("enable", fEnabled,
+    "Enable progress reports.");
+  fMessenger->DeclareProperty("interval", fInterval,
+    "Minimum time between two reports, in seconds.");
+  fMessenger->DeclareProperty("file", fMetricsFile,
+    "Metrics file rewritten at each report: Prometheus text format, "
+    "or JSON if the name ends in .json (none to disable).");
+}
+
+
+Telemetry::~Telemetry()
+{
+  delete fMessenger;
+}
+
+
+void Telemetry::BeginOfRun(G4int events_to_process)
+{
+  fEventsToProcess = events_to_process;
+  fEvents = 0;
+  fSteps = 0.;
+  fStart = Clock::now();
+  fLastReport = fStart;
+}
+
+
+void Telemetry::EndOfEvent(G4int num_steps)
+{
+  fEvents++;
+  fSteps += num_steps;
+
+  if (!fEnabled) return;
+
+  Clock::time_point now = Clock::now();
+  if (std::chrono::duration<G4double>(now - fLastReport).count() < fInterval) return;
+
+  fLastReport = now;
+  Report(false);
+}
+
+
+void Telemetry::EndOfRun()
+{
+  if (fEnabled) Report(true);
+}
+
+
+void Telemetry::Report(G4bool final)
+{
+  G4double elapsed =
+    std::chrono::duration<G4double>(Clock::now() - fStart).count();
+  G4double event_rate = elapsed > 0. ? fEvents/elapsed : 0.;
+  G4double step_rate  = elapsed > 0. ? fSteps/elapsed  : 0.;
+  G4double eta = event_rate > 0. ? (fEventsToProcess - fEvents)/event_rate : 0.;
+  G4double rss = ResidentMemory();
+  // The output file is only written at the end of the run, so its
+  // size is meaningless (negative here) in the periodic reports
+  G4double output = final ? OutputBytes() : -1.;
+
+  G4cout << (final ? "[telemetry] run done: " : "[telemetry] ")
+         << fEvents << "/" << fEventsToProcess << " events, "
+         << event_rate << " events/s, "
+         << step_rate << " steps/s, "
+         << "ETA " << eta << " s, "
+         << "RSS " << rss/1.e6 << " MB";
+  if (output >= 0.) G4cout << ", output " << output/1.e6 << " MB";
+  G4cout << G4endl;
+
+  if (fMetricsFile != "none")
+    WriteMetrics(elapsed, event_rate, step_rate, eta, rss, output);
+}
+
+
+void Telemetry::WriteMetrics(G4double elapsed, G4double event_rate,
+                             G4double step_rate, G4double eta,
+                             G4double rss, G4double output) const
+{
+  // Written to a temporary file and renamed, so that a scraper never
+  // reads a half-written file
+  G4String tmp = fMetricsFile + ".tmp";
+  std::ofstream file(tmp);
+  if (!file) return;
+
+  G4bool json = fMetricsFile.size() > 5 &&
+    fMetricsFile.compare(fMetricsFile.size()-5, 5, ".json") == 0;
+
+  if (json) {
+    file << "{\"events_processed\": " << fEvents
+         << ", \"events_to_process\": " << fEventsToProcess
+         << ", \"steps_processed\": " << fSteps
+         << ", \"elapsed_seconds\": " << elapsed
+         << ", \"events_per_second\": " << event_rate
+         << ", \"steps_per_second\": " << step_rate
+         << ", \"eta_seconds\": " << eta
+         << ", \"resident_memory_bytes\": " << rss;
+    if (output >= 0.) file << ", \"output_bytes\": " << output;
+    file << "}\n";
+  }
+  else {
+    file << "# TYPE g4basic_events_processed counter\n"
+         << "g4basic_events_processed " << fEvents << "\n"
+         << "# TYPE g4basic_events_to_process gauge\n"
+         << "g4basic_events_to_process " << fEventsToProcess << "\n"
+         << "# TYPE g4basic_steps_processed counter\n"
+         << "g4basic_steps_processed " << fSteps << "\n"
+         << "# TYPE g4basic_elapsed_seconds gauge\n"
+         << "g4basic_elapsed_seconds " << elapsed << "\n"
+         << "# TYPE g4basic_events_per_second gauge\n"
+         << "g4basic_events_per_second " << event_rate << "\n"
+         << "# TYPE g4basic_steps_per_second gauge\n"
+         << "g4basic_steps_per_second " << step_rate << "\n"
+         << "# TYPE g4basic_eta_seconds gauge\n"
+         << "g4basic_eta_seconds " << eta << "\n"
+         << "# TYPE g4basic_resident_memory_bytes gauge\n"
+         << "g4basic_resident_memory_bytes " << rss << "\n";
+    if (output >= 0.)
+      file << "# TYPE g4basic_output_bytes gauge\n"
+           << "g4basic_output_bytes " << output << "\n";
+  }
+
+  file.close();
+  std::rename(tmp.c_str(), fMetricsFile.c_str());
+}
+
+
+G4double Telemetry::ResidentMemory()
+{
+  // Second field of /proc/self/statm: resident pages (Linux only)
+  long pages = 0, resident = 0;
+  FILE* statm = std::fopen("/proc/self/statm", "r");
+  if (!statm) return 0.;
+  if (std::fscanf(statm, "%ld %ld", &pages, &resident) != 2) resident = 0;
+  std::fclose(statm);
+  return G4double(resident)*sysconf(_SC_PAGESIZE);
+}
+
+
+G4double Telemetry::OutputBytes() const
+{
+  struct stat info;
+  if (fOutputFile.empty() || stat(fOutputFile.c_str(), &info) != 0) return 0.;
+  return info.st_size;
+}
@@ -0,0 +1,57 @@
+// -----------------------------------------------------------------------------
+//  G4Basic | Telemetry.h
+//
+//  Rate-limited progress reporting of a run (events/s, steps/s, ETA,
+//  resident memory, and output size at the end of the run) to the console
+//  and to a metrics file.
+//   * Author: Taylor Contreras, Justo Martin-Albo
+//   * Creation date: 18 Oct 2026
+// -----------------------------------------------------------------------------
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "globals.hh"
+
+#include <chrono>
+
+class G4GenericMessenger;
+
+
+class Telemetry
+{
+public:
+  Telemetry();
+  ~Telemetry();
+
+  // File whose size is reported as the output bytes, at the end of the
+  // run (it is only written then)
+  void SetOutputFile(const G4String& filename) { fOutputFile = filename; }
+
+  void BeginOfRun(G4int events_to_process);
+  void EndOfEvent(G4int num_steps); // reports only if the interval elapsed
+  void EndOfRun();
+
+private:
+  typedef std::chrono::steady_clock Clock;
+
+  void Report(G4bool final);
+  void WriteMetrics(G4double elapsed, G4double event_rate, G4double step_rate,
+                    G4double eta, G4double rss, G4double output) const;
+  static G4double ResidentMemory(); // bytes
+  G4double OutputBytes() const;
+
+  G4GenericMessenger* fMessenger;
+  G4bool fEnabled;
+  G4double fInterval;    // seconds between reports
+  G4String fMetricsFile; // Prometheus text, or JSON if ending in .json
+  G4String fOutputFile;
+
+  Clock::time_point fStart;
+  Clock::time_point fLastReport;
+  G4int fEventsToProcess;
+  G4int fEvents;
+  G4double fSteps;
+};
+
+#endif
@@ -0,0 +1,109 @@
+// -----------------------------------------------------------------------------
+//  G4Basic | TrackingAction.cpp
+//
+//  Trajectory decimation for the visualization of optical events.
+//   * Author: Taylor Contreras, Justo Martin-Albo
+//   * Creation date: 18 Oct 2026
+// -----------------------------------------------------------------------------
+
+#include "TrackingAction.h"
+#include "EventAction.h"
+
+#include <G4Track.hh>
+#include <G4TrackingManager.hh>
+#include <G4EventManager.hh>
+#include <G4Event.hh>
+#include <G4OpticalPhoton.hh>
+#include <G4GenericMessenger.hh>
+
+TrackingAction::TrackingAction(EventAction* eventAction)
+  : G4UserTrackingAction(),
+    fEventAction(eventAction),
+    fMessenger(0),
+    fDecimate(false),
+    fOpticalFraction(0.05),
+    fMaxPoints(100000),
+    fEventID(-1),
+    fStoreMode(0),
+    fPointsLeft(0),
+    fCapped(false)
+{
+  fMessenger = new G4GenericMessenger(this, "/G4Basic/vis/",
+    "Trajectory decimation for visualization.");
+
+  fMessenger->DeclareProperty("decimate", fDecimate,
+    "Store only a fraction of optical photon trajectories and cap the "
+    "points of neutral trajectories (charged ones are kept in full).");
+  fMessenger->DeclareProperty("opticalFraction", fOpticalFraction,
+    "Fraction of optical photon trajectories stored when decimating.");
+  fMessenger->DeclareProperty("maxPoints", fMaxPoints,
+    "Maximum trajectory points stored per event for neutral particles.");
+}
+
+
+TrackingAction::~TrackingAction()
+{
+  delete fMessenger;
+}
+
+
+G4bool TrackingAction::Sampled(G4int trackid) const
+{
+  // Multiplicative hash of the track ID, so that the sampling is
+  // reproducible and does not consume random numbers from the engine
+  G4double u = (static_cast<unsigned int>(trackid)*2654435761u)/4294967296.;
+  return u < fOpticalFraction;
+}
+
+
+void TrackingAction::PreUserTrackingAction(const G4Track* track)
+{
+  // Counted here, so that tracks killed before their first step count too
+  fEventAction->AddTrack(track->GetDefinition());
+
+  fStoreMode = fpTrackingManager->GetStoreTrajectory();
+  fCapped = false;
+  if (!fDecimate || !fStoreMode) return;
+
+  G4int eventid = G4EventManager::GetEventManager()->GetConstCurrentEvent()->GetEventID();
+  if (eventid != fEventID) {
+    fEventID = eventid;
+    fPointsLeft = fMaxPoints;
+  }
+
+  if (track->GetDefinition()->GetPDGCharge() != 0.) return;
+
+  if (fPointsLeft <= 0 ||
+      (track->GetDefinition() == G4OpticalPhoton::Definition() &&
+       !Sampled(track->GetTrackID()))) {
+    fpTrackingManager->SetStoreTrajectory(0);
+    return;
+  }
+
+  // The tracking manager creates the trajectory of the requested mode
+  // (plain, smooth or rich); its points are capped in AppendStep()
+  fCapped = true;
+}
+
+
+void TrackingAction::AppendStep()
+{
+  if (!fCapped) return;
+  if (fPointsLeft > 0) {
+    fPointsLeft--;
+    return;
+  }
+  // Budget spent: the tracking manager stops appending steps to the
+  // trajectory, which keeps the points stored so far
+  fpTrackingManager->SetStoreTrajectory(0);
+  fCapped = false;
+}
+
+
+void TrackingAction::PostUserTrackingAction(const G4Track*)
+{
+  // Restore the mode for the next track. This runs before the tracking
+  // manager checks the mode to discard the trajectory, so a capped
+  // trajectory is kept.
+  fpTrackingManager->SetStoreTrajectory(fStoreMode);
+}
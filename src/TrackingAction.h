@@ -0,0 +1,48 @@
+// -----------------------------------------------------------------------------
+//  G4Basic | TrackingAction.h
+//
+//  Trajectory decimation for the visualization of optical events: only a
+//  sampled fraction of the optical photon trajectories is stored, and the
+//  points stored for neutral particles are capped per event. Trajectories
+//  of charged particles are always stored in full.
+//   * Author: Taylor Contreras, Justo Martin-Albo
+//   * Creation date: 18 Oct 2026
+// -----------------------------------------------------------------------------
+
+#ifndef TRACKING_ACTION_H
+#define TRACKING_ACTION_H
+
+#include <G4UserTrackingAction.hh>
+
+class G4GenericMessenger;
+class EventAction;
+
+
+class TrackingAction: public G4UserTrackingAction
+{
+public:
+  TrackingAction(EventAction* eventAction);
+  virtual ~TrackingAction();
+  virtual void PreUserTrackingAction(const G4Track*);
+  virtual void PostUserTrackingAction(const G4Track*);
+
+  // Called by the stepping action for every step, before the tracking
+  // manager appends it to the trajectory of the current track
+  void AppendStep();
+
+private:
+  G4bool Sampled(G4int trackid) const;
+
+  EventAction* fEventAction;
+  G4GenericMessenger* fMessenger;
+  G4bool fDecimate;
+  G4double fOpticalFraction; // fraction of optical photon trajectories kept
+  G4int fMaxPoints;          // per event, for neutral particles
+
+  G4int fEventID;
+  G4int fStoreMode; // trajectory mode requested by the vis manager
+  G4int fPointsLeft; // points neutral trajectories may still store in the event
+  G4bool fCapped;    // whether the points of the current track are capped
+};
+
+#endif
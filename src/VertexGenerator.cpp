@@ -0,0 +1,207 @@
+// -----------------------------------------------------------------------------
+//  G4Basic | VertexGenerator.cpp
+//
+//  Batched sampling of primary vertex positions, directions and energies.
+//   * Author: Taylor Contreras, Justo Martin-Albo
+//   * Creation date: 18 Oct 2026
+// -----------------------------------------------------------------------------
+
+#include "VertexGenerator.h"
+
+#include <G4SystemOfUnits.hh>
+#include <G4PhysicalConstants.hh>
+#include <G4Exception.hh>
+#include <Randomize.hh>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+VertexGenerator::VertexGenerator()
+  : fSource(kPoint),
+    fRadius(0.),
+    fLength(0.),
+    fPoint(0.,0.,0.),
+    fDirection(0.,0.,1.),
+    fIsotropic(false),
+    fEnergy(0.),
+    fBatchSize(4096),
+    fSize(0),
+    fNext(0)
+{
+}
+
+
+VertexGenerator::~VertexGenerator()
+{
+}
+
+
+void VertexGenerator::SetSource(const G4String& source)
+{
+  if      (source == "point")   fSource = kPoint;
+  else if (source == "volume")  fSource = kVolume;
+  else if (source == "surface") fSource = kSurface;
+  else
+    G4Exception("VertexGenerator::SetSource()", "[VertexGenerator]",
+                FatalException, ("unknown source type " + source).c_str());
+}
+
+
+void VertexGenerator::SetChamber(G4double radius, G4double length)
+{
+  fRadius = radius;
+  fLength = length;
+}
+
+
+void VertexGenerator::SetEnergy(G4double energy)
+{
+  fEnergy = energy;
+  fSpectrumEnergy.clear();
+  fSpectrumCDF.clear();
+}
+
+
+void VertexGenerator::LoadSpectrum(const G4String& filename)
+{
+  std::ifstream file(filename);
+  if (!file)
+    G4Exception("VertexGenerator::LoadSpectrum()", "[VertexGenerator]",
+                FatalException, ("cannot open spectrum file " + filename).c_str());
+
+  fSpectrumEnergy.clear();
+  fSpectrumCDF.clear();
+
+  G4double total = 0.;
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream iss(line);
+    G4double energy, weight;
+    if (!(iss >> energy >> weight) || weight <= 0.) continue;
+    total += weight;
+    fSpectrumEnergy.push_back(energy*keV);
+    fSpectrumCDF.push_back(total);
+  }
+
+  if (fSpectrumCDF.empty())
+    G4Exception("VertexGenerator::LoadSpectrum()", "[VertexGenerator]",
+                FatalException, ("no lines in spectrum file " + filename).c_str());
+
+  for (size_t i=0; i<fSpectrumCDF.size(); i++) fSpectrumCDF[i] /= total;
+}
+
+
+void VertexGenerator::SetBatchSize(G4int size)
+{
+  fBatchSize = std::max(size, 1);
+}
+
+
+void VertexGenerator::Next(G4ThreeVector& position, G4ThreeVector& direction,
+                           G4double& energy)
+{
+  if (fNext >= fSize) Refill();
+
+  position.set(fX[fNext], fY[fNext], fZ[fNext]);
+  direction.set(fU[fNext], fV[fNext], fW[fNext]);
+  energy = fE[fNext];
+  fNext++;
+}
+
+
+const G4double* VertexGenerator::Uniforms(size_t count)
+{
+  // Draws count uniform numbers per vertex of the batch in a single call
+  // to the engine. The returned buffer is overwritten by the next call.
+  fRandom.resize(count*fBatchSize);
+  G4Random::getTheEngine()->flatArray(fRandom.size(), fRandom.data());
+  return fRandom.data();
+}
+
+
+void VertexGenerator::Refill()
+{
+  const size_t n = fBatchSize;
+  fX.resize(n); fY.resize(n); fZ.resize(n);
+  fU.resize(n); fV.resize(n); fW.resize(n);
+  fE.resize(n);
+
+  // Positions ///////////////////////////////////////////////////////////
+
+  if (fSource == kVolume) {
+    // Uniform in the chamber cylinder
+    const G4double* u = Uniforms(3);
+    for (size_t i=0; i<n; i++) {
+      G4double r   = fRadius*std::sqrt(u[i]);
+      G4double phi = twopi*u[n+i];
+      fX[i] = r*std::cos(phi);
+      fY[i] = r*std::sin(phi);
+      fZ[i] = (u[2*n+i]-0.5)*fLength;
+    }
+  }
+  else if (fSource == kSurface) {
+    // Uniform on the chamber walls: the barrel and the two end caps,
+    // each chosen with a probability proportional to its area
+    G4double side = fLength/(fLength + fRadius);
+    G4double cap  = side + (1.-side)/2.;
+    const G4double* u = Uniforms(3);
+    for (size_t i=0; i<n; i++) {
+      G4double phi = twopi*u[n+i];
+      G4double r, z;
+      if (u[i] < side) {
+        r = fRadius;
+        z = (u[2*n+i]-0.5)*fLength;
+      }
+      else {
+        r = fRadius*std::sqrt(u[2*n+i]);
+        z = (u[i] < cap) ? -fLength/2. : fLength/2.;
+      }
+      fX[i] = r*std::cos(phi);
+      fY[i] = r*std::sin(phi);
+      fZ[i] = z;
+    }
+  }
+  else {
+    std::fill(fX.begin(), fX.end(), fPoint.x());
+    std::fill(fY.begin(), fY.end(), fPoint.y());
+    std::fill(fZ.begin(), fZ.end(), fPoint.z());
+  }
+
+  // Directions //////////////////////////////////////////////////////////
+
+  if (fIsotropic) {
+    const G4double* u = Uniforms(2);
+    for (size_t i=0; i<n; i++) {
+      G4double cost = 1. - 2.*u[i];
+      G4double sint = std::sqrt(std::max(0., 1. - cost*cost));
+      G4double phi  = twopi*u[n+i];
+      fU[i] = sint*std::cos(phi);
+      fV[i] = sint*std::sin(phi);
+      fW[i] = cost;
+    }
+  }
+  else {
+    std::fill(fU.begin(), fU.end(), fDirection.x());
+    std::fill(fV.begin(), fV.end(), fDirection.y());
+    std::fill(fW.begin(), fW.end(), fDirection.z());
+  }
+
+  // Energies ////////////////////////////////////////////////////////////
+
+  if (!fSpectrumCDF.empty()) {
+    const G4double* u = Uniforms(1);
+    for (size_t i=0; i<n; i++) {
+      size_t line = std::upper_bound(fSpectrumCDF.begin(), fSpectrumCDF.end(), u[i])
+                    - fSpectrumCDF.begin();
+      fE[i] = fSpectrumEnergy[std::min(line, fSpectrumEnergy.size()-1)];
+    }
+  }
+  else {
+    std::fill(fE.begin(), fE.end(), fEnergy);
+  }
+
+  fSize = n;
+  fNext = 0;
+}
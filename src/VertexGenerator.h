@@ -0,0 +1,66 @@
+// -----------------------------------------------------------------------------
+//  G4Basic | VertexGenerator.h
+//
+//  Batched sampling of primary vertex positions, directions and energies.
+//   * Author: Taylor Contreras, Justo Martin-Albo
+//   * Creation date: 18 Oct 2026
+// -----------------------------------------------------------------------------
+
+#ifndef VERTEX_GENERATOR_H
+#define VERTEX_GENERATOR_H
+
+#include <G4ThreeVector.hh>
+#include "globals.hh"
+
+#include <vector>
+
+
+class VertexGenerator
+{
+public:
+  VertexGenerator();
+  ~VertexGenerator();
+
+  void SetSource(const G4String& source); // point, volume or surface
+  void SetChamber(G4double radius, G4double length);
+  void SetPoint(const G4ThreeVector& point) { fPoint = point; }
+  void SetDirection(const G4ThreeVector& direction) { fDirection = direction.unit(); }
+  void SetIsotropic(G4bool isotropic) { fIsotropic = isotropic; }
+  void SetEnergy(G4double energy);
+  void LoadSpectrum(const G4String& filename); // lines of "energy[keV] weight"
+  void SetBatchSize(G4int size);
+
+  // Drops the vertices sampled so far (e.g. after a change of settings)
+  void Reset() { fNext = fSize; }
+
+  // Returns the next pre-sampled vertex, sampling a new batch if needed
+  void Next(G4ThreeVector& position, G4ThreeVector& direction, G4double& energy);
+
+private:
+  enum Source { kPoint, kVolume, kSurface };
+
+  void Refill();
+  const G4double* Uniforms(size_t count);
+
+  Source fSource;
+  G4double fRadius;
+  G4double fLength;
+  G4ThreeVector fPoint;
+  G4ThreeVector fDirection;
+  G4bool fIsotropic;
+  G4double fEnergy;
+
+  std::vector<G4double> fSpectrumEnergy; // discrete lines
+  std::vector<G4double> fSpectrumCDF;    // normalized cumulative weights
+
+  // Current batch, stored as one array per coordinate
+  size_t fBatchSize;
+  size_t fSize;
+  size_t fNext;
+  std::vector<G4double> fX, fY, fZ;
+  std::vector<G4double> fU, fV, fW;
+  std::vector<G4double> fE;
+  std::vector<G4double> fRandom;
+};
+
+#endif
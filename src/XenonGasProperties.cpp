@@ -0,0 +1,231 @@
+// -----------------------------------------------------------------------------
+//  G4Basic | XenonGasProperties.cpp
+//
+//  Pressure- and temperature-dependent properties of gaseous xenon.
+//   * Author: Taylor Contreras, Justo Martin-Albo
+//   * Creation date: 18 Oct 2026
+// -----------------------------------------------------------------------------
+
+#include "XenonGasProperties.h"
+
+#include <G4SystemOfUnits.hh>
+#include <G4Version.hh>
+#include <G4PhysicalConstants.hh>
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdint.h>
+
+namespace {
+
+  const char kMagic[8] = {'G','4','B','G','X','E','0','1'};
+  // To be increased whenever the grid or the property models change,
+  // so that files written by earlier versions are regenerated
+  const uint32_t kVersion = 1;
+
+  // Photon energy grid, covering the second continuum of xenon
+  const G4int    kNumPoints = 401;
+  const G4double kEmin = 6.0*eV;
+  const G4double kEmax = 8.0*eV;
+
+  // Scintillation peak (172 nm) and its gaussian width (14 nm FWHM)
+  const G4double kScintPeak  = 7.21*eV;
+  const G4double kScintSigma = 0.25*eV;
+
+  const G4double kMolarMass = 131.293*g/mole;
+
+}
+
+
+UniformPropertyVector::UniformPropertyVector(G4double emin, G4double emax,
+                                             const std::vector<G4double>& values)
+  : G4MaterialPropertyVector()
+{
+  size_t n = values.size();
+  G4double step = (emax - emin)/(n - 1);
+  for (size_t i=0; i<n; i++) InsertValues(emin + i*step, values[i]);
+
+#if G4VERSION_NUMBER < 1100
+  // Let FindBinLocation() use the linear-grid arithmetic
+  type = T_G4PhysicsLinearVector;
+  dBin = step;
+  baseBin = emin/step;
+#endif
+}
+
+
+XenonGasProperties::XenonGasProperties()
+  : fPressure(0.),
+    fTemperature(0.),
+    fDensity(0.),
+    fEmin(kEmin),
+    fEmax(kEmax)
+{
+}
+
+
+XenonGasProperties::~XenonGasProperties()
+{
+}
+
+
+G4double XenonGasProperties::Density(G4double pressure, G4double temperature)
+{
+  // Virial equation of state, Z = 1 + B(T)·rho + C·rho^2 (rho molar density),
+  // with B(T) from the Tsonopoulos correlation for xenon
+  // (Tc = 289.73 K, Pc = 58.42 bar, acentric factor 0.008).
+
+  const G4double Tc = 289.73*kelvin;
+  const G4double Pc = 58.42*bar;
+  const G4double omega = 0.008;
+  const G4double C = 2970.*cm3*cm3/(mole*mole);
+
+  G4double Tr = temperature/Tc;
+  G4double f0 = 0.1445 - 0.330/Tr - 0.1385/std::pow(Tr,2)
+    - 0.0121/std::pow(Tr,3) - 0.000607/std::pow(Tr,8);
+  G4double f1 = 0.0637 + 0.331/std::pow(Tr,2)
+    - 0.423/std::pow(Tr,3) - 0.008/std::pow(Tr,8);
+  G4double B = (f0 + omega*f1)*k_Boltzmann*Avogadro*Tc/Pc;
+
+  G4double RT = k_Boltzmann*Avogadro*temperature;
+  G4double rho = pressure/RT; // ideal gas as starting point
+  for (G4int i=0; i<50; i++) {
+    G4double next = pressure/(RT*(1. + B*rho + C*rho*rho));
+    if (std::abs(next - rho) < 1.e-12*rho) { rho = next; break; }
+    rho = next;
+  }
+
+  return rho*kMolarMass;
+}
+
+
+G4double XenonGasProperties::RefractiveIndex(G4double energy, G4double density)
+{
+  // Lorentz-Lorenz relation, (n^2-1)/(n^2+2) = -A(E)·rho, with the
+  // refractivity virial coefficient A(E) = sum_i P_i/(E^2 - E_i^2) from
+  // A. Baldini et al., arXiv:physics/0401072 (E in eV, P in eV^2 cm3/mole).
+
+  const G4double P[3] = {71.23, 77.75, 1384.89};
+  const G4double E[3] = {8.4, 8.81, 13.2};
+
+  G4double e = energy/eV;
+  G4double virial = 0.;
+  for (G4int i=0; i<3; i++) virial += P[i]/(e*e - E[i]*E[i]);
+
+  G4double alpha = virial*(density/(g/cm3))/(kMolarMass/(g/mole));
+  G4double n2 = (1. - 2.*alpha)/(1. + alpha);
+  return n2 > 1. ? std::sqrt(n2) : 1.;
+}
+
+
+void XenonGasProperties::Generate(G4double pressure, G4double temperature)
+{
+  fPressure = pressure;
+  fTemperature = temperature;
+  fDensity = Density(pressure, temperature);
+  fEmin = kEmin;
+  fEmax = kEmax;
+
+  fScintillation.resize(kNumPoints);
+  fRefractiveIndex.resize(kNumPoints);
+  fAbsorptionLength.resize(kNumPoints);
+
+  G4double step = (fEmax - fEmin)/(kNumPoints - 1);
+  for (G4int i=0; i<kNumPoints; i++) {
+    G4double energy = fEmin + i*step;
+    G4double x = (energy - kScintPeak)/kScintSigma;
+    fScintillation[i] = std::exp(-0.5*x*x);
+    fRefractiveIndex[i] = RefractiveIndex(energy, fDensity);
+    fAbsorptionLength[i] = 1.e8*m; // no absorption
+  }
+}
+
+
+G4bool XenonGasProperties::Load(const G4String& filename,
+                                G4double pressure, G4double temperature)
+{
+  std::ifstream file(filename, std::ios::binary);
+  if (!file) return false;
+
+  char magic[8];
+  uint32_t version, n;
+  double header[5];
+  file.read(magic, sizeof(magic));
+  file.read(reinterpret_cast<char*>(&version), sizeof(version));
+  file.read(reinterpret_cast<char*>(&n), sizeof(n));
+  file.read(reinterpret_cast<char*>(header), sizeof(header));
+  if (!file || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      version != kVersion) return false;
+
+  // The grid must be the one Generate() would use (this also bounds
+  // the size of the tables before they are allocated)
+  if (n != static_cast<uint32_t>(kNumPoints) ||
+      std::abs(header[3]*eV - kEmin) > 1.e-9*kEmin ||
+      std::abs(header[4]*eV - kEmax) > 1.e-9*kEmax) return false;
+
+  // Tables are only valid for the conditions they were generated for
+  if (std::abs(header[0]*bar - pressure) > 1.e-9*pressure ||
+      std::abs(header[1]*kelvin - temperature) > 1.e-9*temperature) return false;
+
+  std::vector<G4double> scint(n), rindex(n), abslength(n);
+  file.read(reinterpret_cast<char*>(scint.data()),     n*sizeof(double));
+  file.read(reinterpret_cast<char*>(rindex.data()),    n*sizeof(double));
+  file.read(reinterpret_cast<char*>(abslength.data()), n*sizeof(double));
+  if (!file) return false;
+
+  fPressure = pressure;
+  fTemperature = temperature;
+  fDensity = header[2]*kg/m3;
+  fEmin = header[3]*eV;
+  fEmax = header[4]*eV;
+  fScintillation.swap(scint);
+  fRefractiveIndex.swap(rindex);
+  fAbsorptionLength.swap(abslength);
+  for (size_t i=0; i<n; i++) fAbsorptionLength[i] *= m;
+
+  return true;
+}
+
+
+void XenonGasProperties::Save(const G4String& filename) const
+{
+  std::ofstream file(filename, std::ios::binary);
+  if (!file) {
+    G4Exception("XenonGasProperties::Save()", "[XenonGasProperties]",
+                JustWarning, ("cannot write " + filename).c_str());
+    return;
+  }
+
+  uint32_t n = fScintillation.size();
+  double header[5] = { fPressure/bar, fTemperature/kelvin, fDensity/(kg/m3),
+                       fEmin/eV, fEmax/eV };
+  std::vector<double> abslength(n);
+  for (size_t i=0; i<n; i++) abslength[i] = fAbsorptionLength[i]/m;
+
+  file.write(kMagic, sizeof(kMagic));
+  file.write(reinterpret_cast<const char*>(&kVersion), sizeof(kVersion));
+  file.write(reinterpret_cast<const char*>(&n), sizeof(n));
+  file.write(reinterpret_cast<const char*>(header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(fScintillation.data()),   n*sizeof(double));
+  file.write(reinterpret_cast<const char*>(fRefractiveIndex.data()), n*sizeof(double));
+  file.write(reinterpret_cast<const char*>(abslength.data()),        n*sizeof(double));
+}
+
+
+G4MaterialPropertyVector* XenonGasProperties::Scintillation() const
+{
+  return new UniformPropertyVector(fEmin, fEmax, fScintillation);
+}
+
+
+G4MaterialPropertyVector* XenonGasProperties::RefractiveIndex() const
+{
+  return new UniformPropertyVector(fEmin, fEmax, fRefractiveIndex);
+}
+
+
+G4MaterialPropertyVector* XenonGasProperties::AbsorptionLength() const
+{
+  return new UniformPropertyVector(fEmin, fEmax, fAbsorptionLength);
+}
@@ -0,0 +1,77 @@
+// -----------------------------------------------------------------------------
+//  G4Basic | XenonGasProperties.h
+//
+//  Pressure- and temperature-dependent properties of gaseous xenon: density
+//  and optical property tables on a uniform photon-energy grid. Tables can be
+//  saved to and loaded from a compact binary file, laid out as
+//    char[8]  "G4BGXE01"
+//    uint32   version of the tables (grid and property models)
+//    uint32   number of grid points N
+//    float64  pressure [bar], temperature [K], density [kg/m3],
+//             minimum and maximum photon energy [eV]
+//    float64  scintillation spectrum[N], refractive index[N],
+//             absorption length[N] [m]
+//   * Author: Taylor Contreras, Justo Martin-Albo
+//   * Creation date: 18 Oct 2026
+// -----------------------------------------------------------------------------
+
+#ifndef XENON_GAS_PROPERTIES_H
+#define XENON_GAS_PROPERTIES_H
+
+#include <G4MaterialPropertyVector.hh>
+#include "globals.hh"
+
+#include <vector>
+
+
+// Property vector whose energies are known to be uniformly spaced, so that
+// Geant4 finds the bin of an energy arithmetically instead of by a binary
+// search over the grid. This relies on the internals of the Geant4 10
+// G4PhysicsVector (FindBinLocation() switching on the vector type, with
+// dBin as the bin width and baseBin as the first bin); with later versions
+// it is a plain free vector.
+class UniformPropertyVector: public G4MaterialPropertyVector
+{
+public:
+  UniformPropertyVector(G4double emin, G4double emax,
+                        const std::vector<G4double>& values);
+};
+
+
+class XenonGasProperties
+{
+public:
+  XenonGasProperties();
+  ~XenonGasProperties();
+
+  // Computes density and tables for the given conditions
+  void Generate(G4double pressure, G4double temperature);
+
+  // Reads tables from file; returns false if the file does not exist,
+  // was written by another version or for another grid, or was generated
+  // for other conditions
+  G4bool Load(const G4String& filename, G4double pressure, G4double temperature);
+  void Save(const G4String& filename) const;
+
+  G4double GetDensity() const { return fDensity; }
+
+  // New property vectors (owned by the caller, i.e. the properties table)
+  G4MaterialPropertyVector* Scintillation() const;
+  G4MaterialPropertyVector* RefractiveIndex() const;
+  G4MaterialPropertyVector* AbsorptionLength() const;
+
+private:
+  static G4double Density(G4double pressure, G4double temperature);
+  static G4double RefractiveIndex(G4double energy, G4double density);
+
+  G4double fPressure;
+  G4double fTemperature;
+  G4double fDensity;
+  G4double fEmin;
+  G4double fEmax;
+  std::vector<G4double> fScintillation;
+  std::vector<G4double> fRefractiveIndex;
+  std::vector<G4double> fAbsorptionLength;
+};
+
+#endif